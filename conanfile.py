@@ -11,10 +11,10 @@ class RDFParser(ConanFile):
     url = homepage
     license = "AGPL"
     options = {'with_tests': [False, True]}
-    default_options = {'with_tests': False}
+    default_options = {'with_tests': False, 'boost:lzma': True, 'boost:zstd': True}
     topics = ("dice-group", "RDF", "parser", "semantic web", "turtle", "ntriple")
     settings = "build_type", "compiler", "os", "arch"
-    requires = "boost/1.75.0", "taocpp-pegtl/3.1.0", "fmt/7.1.2", "dice-hash/0.1.0@dice-group/stable" , "robin-hood-hashing/3.9.1"
+    requires = "boost/1.75.0", "taocpp-pegtl/3.1.0", "fmt/7.1.2", "dice-hash/0.1.0@dice-group/stable" , "robin-hood-hashing/3.9.1", "zlib/1.2.11", "zstd/1.4.8"
     generators = "cmake", "cmake_find_package", "cmake_paths"
     exports = "LICENSE"
     exports_sources = "include/*", "CMakeLists.txt", "cmake/dummy-config.cmake.in"
@@ -3,8 +3,10 @@
 
 #include "Dice/RDF/Term.hpp"
 #include "Dice/rdf-parser/internal/Turtle/Actions/BasicActions.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Control.hpp"
 #include "Dice/rdf-parser/internal/Turtle/Grammar.hpp"
 #include "Dice/rdf-parser/internal/Turtle/States/BasicState.hpp"
+#include "Dice/rdf-parser/internal/util/ParseErrors.hpp"
 
 namespace Dice::rdf {
 	/**
@@ -16,12 +18,15 @@ namespace Dice::rdf {
 	inline Term parse_term(const std::string &identifier) {
 		try {
 			using namespace tao::pegtl;
-			string_input input(identifier, "the text");
+			memory_input<tracking_mode::lazy> input(identifier, "the text");
 			Dice::rdf_parser::internal::Turtle::States::BasicState state;
-			parse<Dice::rdf_parser::internal::Turtle::Grammar::term, Dice::rdf_parser::internal::Turtle::Actions::action>(input, state);
+			parse<Dice::rdf_parser::internal::Turtle::Grammar::term, Dice::rdf_parser::internal::Turtle::Actions::action, Dice::rdf_parser::internal::Turtle::control>(input, state);
 			return std::move(state.getElement());
+		} catch (const tao::pegtl::parse_error &e) {
+			auto error = Dice::rdf_parser::internal::util::fromParseError(e, identifier);
+			throw std::logic_error{fmt::format("{} is not a valid term: {}", identifier, error.what())};
 		} catch (const std::exception &e) {
-			throw std::logic_error{fmt::format("{} is not a valid term.")};
+			throw std::logic_error{fmt::format("{} is not a valid term: {}", identifier, e.what())};
 		}
 	}
 
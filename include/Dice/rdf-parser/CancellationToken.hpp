@@ -0,0 +1,31 @@
+#ifndef RDF_PARSER_CANCELLATIONTOKEN_HPP
+#define RDF_PARSER_CANCELLATIONTOKEN_HPP
+
+/**
+ * A CancellationToken asks a parser to stop. Copies share their state, so a token obtained from a parser can be
+ * handed to another thread, e.g. a UI that closes a preview. Parsers check it between statements.
+ */
+
+#include <atomic>
+#include <memory>
+
+namespace Dice::rdf_parser {
+
+	class CancellationToken {
+		std::shared_ptr<std::atomic_bool> cancelled_ = std::make_shared<std::atomic_bool>(false);
+
+	public:
+		/**
+		 * Requests the parser to stop. Triples that were parsed already may still be returned until the parser notices it.
+		 */
+		void cancel() const noexcept {
+			cancelled_->store(true, std::memory_order_relaxed);
+		}
+
+		[[nodiscard]] bool cancelled() const noexcept {
+			return cancelled_->load(std::memory_order_relaxed);
+		}
+	};
+}// namespace Dice::rdf_parser
+
+#endif//RDF_PARSER_CANCELLATIONTOKEN_HPP
@@ -0,0 +1,61 @@
+#ifndef RDF_PARSER_CHECKPOINT_HPP
+#define RDF_PARSER_CHECKPOINT_HPP
+
+/**
+ * A Checkpoint is the position of a parse between two statements together with everything needed to continue from there:
+ * the prefixes, the base and the counter for blank node labels. A TurtleFileParser that resumes from a checkpoint seeks
+ * to its offset and produces exactly the triples, including blank node labels, that the original parse produced after it.
+ *
+ * Checkpoints are serialized to a small platform-independent binary string, so they can be stored in the same
+ * transaction as the triples that were consumed up to them.
+ */
+
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "Dice/rdf-parser/internal/Turtle/States/StatementContext.hpp"
+#include "Dice/rdf-parser/internal/util/BinaryFormat.hpp"
+
+namespace Dice::rdf_parser {
+
+	struct Checkpoint {
+		// byte offset in the file after the last completed statement
+		std::size_t offset = 0;
+		// number of triples of the file before offset
+		std::size_t triples = 0;
+		internal::Turtle::States::StatementContext context;
+
+		[[nodiscard]] std::string serialize() const {
+			std::ostringstream out{std::ios::binary};
+			out.write(magic.data(), magic.size());
+			internal::util::writeNumber(out, offset);
+			internal::util::writeNumber(out, triples);
+			internal::util::writeContext(out, context);
+			return std::move(out).str();
+		}
+
+		/**
+		 * @throws std::runtime_error if data is not a serialized checkpoint
+		 */
+		static Checkpoint deserialize(std::string_view data) {
+			std::istringstream in{std::string{data}, std::ios::binary};
+			std::string read_magic(magic.size(), '\0');
+			in.read(read_magic.data(), static_cast<std::streamsize>(read_magic.size()));
+			if (not in or read_magic != magic)
+				throw std::runtime_error{"not a serialized checkpoint"};
+			Checkpoint checkpoint;
+			checkpoint.offset = internal::util::readNumber(in);
+			checkpoint.triples = internal::util::readNumber(in);
+			checkpoint.context = internal::util::readContext(in);
+			return checkpoint;
+		}
+
+	private:
+		static constexpr std::string_view magic{"RDFPCKP1"};
+	};
+}// namespace Dice::rdf_parser
+
+#endif//RDF_PARSER_CHECKPOINT_HPP
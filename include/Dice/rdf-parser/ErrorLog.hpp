@@ -0,0 +1,89 @@
+#ifndef RDF_PARSER_ERRORLOG_HPP
+#define RDF_PARSER_ERRORLOG_HPP
+
+/**
+ * An ErrorLog collects the errors of a parse that recovers from them by skipping invalid statements.
+ * All errors are counted, but only the first few are kept, so a broken file cannot exhaust the memory.
+ * It may be read from another thread while the parse is running.
+ */
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Dice/rdf-parser/exception/RDFParsingExecption.hpp"
+
+namespace Dice::rdf_parser {
+
+	class ErrorLog {
+		mutable std::mutex m_;
+		std::size_t max_entries_;
+		std::vector<exception::RDFParsingException> entries_;
+		std::size_t count_ = 0;
+
+	public:
+		/**
+		 * @param max_entries number of errors that are kept with their position
+		 */
+		explicit ErrorLog(std::size_t max_entries = 1000) : max_entries_{max_entries} {}
+
+		void setMaxEntries(std::size_t max_entries) {
+			std::lock_guard<std::mutex> lk(m_);
+			max_entries_ = max_entries;
+		}
+
+		void add(exception::RDFParsingException error) {
+			std::lock_guard<std::mutex> lk(m_);
+			++count_;
+			if (entries_.size() < max_entries_)
+				entries_.push_back(std::move(error));
+		}
+
+		/**
+		 * @return number of errors, including those that were not kept
+		 */
+		[[nodiscard]] std::size_t count() const {
+			std::lock_guard<std::mutex> lk(m_);
+			return count_;
+		}
+
+		/**
+		 * @return the first errors in the order they occurred
+		 */
+		[[nodiscard]] std::vector<exception::RDFParsingException> entries() const {
+			std::lock_guard<std::mutex> lk(m_);
+			return entries_;
+		}
+
+		/**
+		 * @return whether errors were dropped because the maximal number of entries was reached
+		 */
+		[[nodiscard]] bool truncated() const {
+			std::lock_guard<std::mutex> lk(m_);
+			return count_ > entries_.size();
+		}
+
+		/**
+		 * @return one line per kept error and a last line with the number of dropped errors, if any
+		 */
+		[[nodiscard]] std::string summary() const {
+			std::lock_guard<std::mutex> lk(m_);
+			std::string text = fmt::format("{} invalid statements skipped\n", count_);
+			for (const auto &error : entries_) {
+				if (error.hasPosition())
+					text += fmt::format("line {}, column {} (byte {}): {}\n", error.line(), error.column(), error.offset(), error.reason());
+				else
+					text += error.reason() + '\n';
+			}
+			if (count_ > entries_.size())
+				text += fmt::format("{} more errors not logged\n", count_ - entries_.size());
+			return text;
+		}
+	};
+}// namespace Dice::rdf_parser
+
+#endif//RDF_PARSER_ERRORLOG_HPP
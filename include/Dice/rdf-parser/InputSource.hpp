@@ -0,0 +1,173 @@
+#ifndef RDF_PARSER_INPUTSOURCE_HPP
+#define RDF_PARSER_INPUTSOURCE_HPP
+
+/**
+ * Input sources let the parsers read from other places than a named file or an owned std::string:
+ * file descriptors, stdin and pipes, std::istream, memory that is owned by the caller and callbacks.
+ *
+ * An InputSource provides read(buffer, length), which reads at most length bytes and returns 0 at the end, and a name
+ * that is used in error messages. Sources whose whole content is in memory additionally provide contiguous(); parsers
+ * that parse at once use it directly instead of copying the content. Sources whose read can block, like pipes, may
+ * provide interruptOn(token, poll_milliseconds); a cancelled parser then stops waiting for them.
+ */
+
+#include <algorithm>
+#include <concepts>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "Dice/rdf-parser/CancellationToken.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Inputs/FileDescriptorReader.hpp"
+
+namespace Dice::rdf_parser {
+
+	template<typename T>
+	concept InputSource = requires(T &source, char *buffer, std::size_t length) {
+		{ source.read(buffer, length) } -> std::convertible_to<std::size_t>;
+		{ source.name() } -> std::convertible_to<std::string>;
+	};
+
+	template<typename T>
+	concept ContiguousInputSource = InputSource<T> and requires(const T &source) {
+		{ source.contiguous() } -> std::convertible_to<std::string_view>;
+	};
+
+	template<typename T>
+	concept InterruptibleInputSource = InputSource<T> and requires(T &source, CancellationToken cancellation, int poll_milliseconds) {
+		source.interruptOn(cancellation, poll_milliseconds);
+	};
+
+	namespace sources {
+
+		/**
+		 * Reads a file descriptor, e.g. a file, a pipe or a socket.
+		 */
+		class FileDescriptor {
+			internal::Turtle::Inputs::FileDescriptorReader reader_;
+			std::string name_;
+
+		public:
+			/**
+			 * @param fd the file descriptor; it is read from its current offset
+			 * @param owns whether the file descriptor is closed when the source is destroyed
+			 */
+			explicit FileDescriptor(int fd, bool owns = false, std::string name = "file descriptor")
+				: reader_{fd, owns}, name_{std::move(name)} {}
+
+			/**
+			 * Opens a file, fifo or device.
+			 */
+			explicit FileDescriptor(const std::filesystem::path &path) : reader_{path}, name_{path.string()} {}
+
+			std::size_t read(char *buffer, std::size_t length) { return reader_(buffer, length); }
+
+			/**
+			 * Lets read return 0 once cancellation is cancelled while it waits for a pipe, socket or terminal.
+			 */
+			void interruptOn(CancellationToken cancellation, int poll_milliseconds) {
+				reader_.interruptOn(std::move(cancellation), poll_milliseconds);
+			}
+
+			[[nodiscard]] const std::string &name() const noexcept { return name_; }
+		};
+
+		/**
+		 * Reads the standard input, e.g. the output of curl or zcat piped into the process.
+		 */
+		class Stdin : public FileDescriptor {
+		public:
+			Stdin() : FileDescriptor{0, false, "stdin"} {}
+		};
+
+		/**
+		 * Reads a std::istream that is owned by the caller.
+		 */
+		class Istream {
+			std::istream &stream_;
+			std::string name_;
+
+		public:
+			explicit Istream(std::istream &stream, std::string name = "stream") : stream_{stream}, name_{std::move(name)} {}
+
+			std::size_t read(char *buffer, std::size_t length) {
+				stream_.read(buffer, static_cast<std::streamsize>(length));
+				if (const auto r = stream_.gcount())
+					return static_cast<std::size_t>(r);
+				if (stream_.eof())
+					return 0;
+				throw std::runtime_error("error reading from the input stream");
+			}
+
+			[[nodiscard]] const std::string &name() const noexcept { return name_; }
+		};
+
+		/**
+		 * Reads memory that is owned by the caller and must outlive the parser.
+		 */
+		class Memory {
+			std::string_view data_;
+			std::size_t pos_ = 0;
+			std::string name_;
+
+		public:
+			explicit Memory(std::string_view data, std::string name = "memory") : data_{data}, name_{std::move(name)} {}
+
+			std::size_t read(char *buffer, std::size_t length) {
+				const std::size_t n = std::min(length, data_.size() - pos_);
+				std::memcpy(buffer, data_.data() + pos_, n);
+				pos_ += n;
+				return n;
+			}
+
+			[[nodiscard]] std::string_view contiguous() const noexcept { return data_; }
+
+			[[nodiscard]] const std::string &name() const noexcept { return name_; }
+		};
+
+		/**
+		 * Pulls the input from a callback that reads at most length bytes into buffer and returns 0 at the end.
+		 */
+		class Callback {
+			std::function<std::size_t(char *buffer, std::size_t length)> callback_;
+			std::string name_;
+
+		public:
+			explicit Callback(std::function<std::size_t(char *buffer, std::size_t length)> callback, std::string name = "callback")
+				: callback_{std::move(callback)}, name_{std::move(name)} {}
+
+			std::size_t read(char *buffer, std::size_t length) { return callback_(buffer, length); }
+
+			[[nodiscard]] const std::string &name() const noexcept { return name_; }
+		};
+	}// namespace sources
+
+	namespace internal::util {
+		/**
+		 * Reads a source to its end.
+		 */
+		template<InputSource Source>
+		std::string readAll(Source &source) {
+			std::string content;
+			std::size_t size = 0;
+			for (;;) {
+				content.resize(std::max<std::size_t>(content.size() * 2, 64 * 1024));
+				while (size < content.size()) {
+					const std::size_t r = source.read(content.data() + size, content.size() - size);
+					if (r == 0) {
+						content.resize(size);
+						return content;
+					}
+					size += r;
+				}
+			}
+		}
+	}// namespace internal::util
+}// namespace Dice::rdf_parser
+
+#endif//RDF_PARSER_INPUTSOURCE_HPP
@@ -0,0 +1,212 @@
+#ifndef RDF_PARSER_LINT_HPP
+#define RDF_PARSER_LINT_HPP
+
+/**
+ * lint() checks the syntax of a large document with all cores. Like TurtleStringParser::isParsable it runs the grammar
+ * without actions, so no triples are built. The document is split into chunks at statement boundaries and the chunks are
+ * checked by several threads. An invalid statement is skipped up to the next '.' at the end of a line, so all errors
+ * are found in one run.
+ *
+ * Only the syntax is checked: prefixes are not resolved, so undefined prefixes are not reported.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/mman.h>
+
+#include <tao/pegtl.hpp>
+
+#include "Dice/rdf-parser/exception/RDFParsingExecption.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Control.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Grammar.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Parsers/StatementBoundary.hpp"
+#include "Dice/rdf-parser/internal/util/Compression.hpp"
+#include "Dice/rdf-parser/internal/util/FileMapping.hpp"
+
+namespace Dice::rdf_parser {
+
+	struct LintOptions {
+		// 0 uses one thread per hardware thread
+		std::size_t threads = 0;
+		// the document is split into chunks of about this size
+		std::size_t chunk_size = 16 * 1024 * 1024;
+		// errors that are kept with their position; all errors are counted
+		std::size_t max_errors = 1000;
+	};
+
+	struct LintReport {
+		std::size_t bytes = 0;
+		// statements without errors
+		std::size_t statements = 0;
+		// number of invalid statements, including those that were not kept
+		std::size_t error_count = 0;
+		// the first errors in document order, with offset, line, column and snippet
+		std::vector<exception::RDFParsingException> errors;
+
+		[[nodiscard]] bool valid() const noexcept { return error_count == 0; }
+	};
+
+	namespace internal::Turtle::Parsers::lint {
+
+		struct Error {
+			std::size_t offset;
+			std::string reason;
+		};
+
+		struct ChunkResult {
+			std::size_t statements = 0;
+			std::size_t error_count = 0;
+			std::vector<Error> errors;
+			// positions of the kept errors, relative to the begin of the chunk
+			std::vector<std::pair<std::size_t, std::size_t>> lines_and_line_begins;
+			std::size_t newlines = 0;
+		};
+
+		/**
+		 * Checks the statements in [begin, end) of the document.
+		 */
+		inline ChunkResult checkChunk(std::string_view document, std::size_t begin, std::size_t end, std::size_t max_errors) {
+			using Input = boundary::Input;
+			ChunkResult result;
+			const char *const chunk_end = document.data() + end;
+			std::size_t input_begin = begin;
+			for (;;) {
+				// after an error the input restarts behind it, so positions of errors are computed from close by
+				Input in(document.data() + input_begin, chunk_end, "lint");
+				bool failed = false;
+				while (not failed) {
+					tao::pegtl::parse<Grammar::ignored>(in);
+					if (in.empty())
+						break;
+					try {
+						// a statement that does not match fails at its begin, like the grammar of the whole document
+						if (tao::pegtl::parse<Grammar::statement, tao::pegtl::nothing, control>(in))
+							++result.statements;
+						else
+							tao::pegtl::parse<tao::pegtl::must<tao::pegtl::eof>>(in);
+					} catch (const tao::pegtl::parse_error &e) {
+						const std::size_t statement_begin = static_cast<std::size_t>(in.current() - document.data());
+						const std::size_t offset = e.positions().empty() ? statement_begin : input_begin + e.positions().front().byte;
+						if (++result.error_count <= max_errors)
+							result.errors.push_back({std::max(offset, statement_begin), e.what()});
+						Input skip(document.data() + std::max(offset, statement_begin), chunk_end, "lint");
+						tao::pegtl::parse<Grammar::skipStatement>(skip);
+						input_begin = static_cast<std::size_t>(skip.current() - document.data());
+						failed = true;
+					}
+				}
+				if (not failed)
+					break;
+			}
+
+			// lines are counted relative to the chunk in one pass
+			std::size_t counted = begin;
+			std::size_t line_begin = begin;
+			for (const auto &error : result.errors) {
+				for (std::size_t newline = document.find('\n', counted); newline < error.offset; newline = document.find('\n', newline + 1)) {
+					++result.newlines;
+					line_begin = newline + 1;
+				}
+				counted = error.offset;
+				result.lines_and_line_begins.emplace_back(result.newlines, line_begin);
+			}
+			result.newlines += static_cast<std::size_t>(std::count(document.begin() + static_cast<std::ptrdiff_t>(counted),
+																	document.begin() + static_cast<std::ptrdiff_t>(end), '\n'));
+			return result;
+		}
+	}// namespace internal::Turtle::Parsers::lint
+
+	/**
+	 * Checks the syntax of an in-memory N-Triples or Turtle document.
+	 * @param document the document
+	 * @param options threads, chunk size and number of kept errors
+	 * @return counts and the first errors
+	 */
+	inline LintReport lint(std::string_view document, const LintOptions &options = {}) {
+		namespace Parsers = internal::Turtle::Parsers;
+		const std::size_t chunk_size = std::max<std::size_t>(options.chunk_size, 1);
+		const std::size_t chunks = std::max<std::size_t>((document.size() + chunk_size - 1) / chunk_size, 1);
+		std::size_t threads = options.threads != 0 ? options.threads : std::max(std::thread::hardware_concurrency(), 1u);
+		threads = std::min(threads, chunks);
+
+		auto runParallel = [&](auto &&task) {
+			std::atomic<std::size_t> next{0};
+			std::mutex m;
+			std::exception_ptr error;
+			auto work = [&] {
+				try {
+					for (std::size_t i = next++; i < chunks; i = next++)
+						task(i);
+				} catch (...) {
+					std::lock_guard<std::mutex> lk(m);
+					error = std::current_exception();
+				}
+			};
+			std::vector<std::thread> workers;
+			for (std::size_t i = 1; i < threads; ++i)
+				workers.emplace_back(work);
+			work();
+			for (auto &worker : workers)
+				worker.join();
+			if (error)
+				std::rethrow_exception(error);
+		};
+
+		// the chunks start at the first statement boundary after multiples of the chunk size. The search stops at the next
+		// chunk, so a chunk without any boundary, e.g. of an invalid document, starts at its first line instead.
+		std::vector<std::size_t> boundaries(chunks + 1, document.size());
+		runParallel([&](std::size_t i) {
+			boundaries[i] = Parsers::nextStatementBoundary(document, i * chunk_size, (i + 1) * chunk_size);
+		});
+		for (std::size_t i = 1; i < chunks; ++i)
+			boundaries[i] = std::max(boundaries[i], boundaries[i - 1]);
+
+		std::vector<Parsers::lint::ChunkResult> results(chunks);
+		runParallel([&](std::size_t i) {
+			results[i] = Parsers::lint::checkChunk(document, boundaries[i], boundaries[i + 1], options.max_errors);
+		});
+
+		LintReport report;
+		report.bytes = document.size();
+		std::size_t lines_before = 0;
+		for (const auto &result : results) {
+			report.statements += result.statements;
+			report.error_count += result.error_count;
+			for (std::size_t j = 0; j < result.errors.size() and report.errors.size() < options.max_errors; ++j) {
+				const auto &error = result.errors[j];
+				const auto [line, line_begin] = result.lines_and_line_begins[j];
+				report.errors.emplace_back(error.reason, error.offset, lines_before + line + 1, error.offset - line_begin + 1,
+										   exception::RDFParsingException::snippetAt(document.substr(line_begin), error.offset - line_begin));
+			}
+			lines_before += result.newlines;
+		}
+		return report;
+	}
+
+	/**
+	 * Checks the syntax of an uncompressed N-Triples or Turtle file. The file is mapped into memory.
+	 * @param path a regular, uncompressed file
+	 * @param options threads, chunk size and number of kept errors
+	 * @return counts and the first errors
+	 */
+	inline LintReport lint(const std::filesystem::path &path, const LintOptions &options = {}) {
+		if (internal::util::detectCompression(path) != Compression::None)
+			throw std::invalid_argument{"linting splits the file into chunks, " + path.string() + " is compressed"};
+		internal::util::FileMapping mapping{path};
+		mapping.advise(MADV_SEQUENTIAL);
+		return lint(std::string_view{mapping.data(), mapping.size()}, options);
+	}
+}// namespace Dice::rdf_parser
+
+#endif//RDF_PARSER_LINT_HPP
@@ -0,0 +1,182 @@
+#ifndef RDF_PARSER_OPEN_HPP
+#define RDF_PARSER_OPEN_HPP
+
+/**
+ * open() picks the parser that fits a file best and returns it behind one interface:
+ *  - small files are read into a string and parsed at once (TurtleStringParser),
+ *  - medium files are mapped into memory and parsed while they are iterated (TurtleMmapParser),
+ *  - large files, compressed files and pipes are streamed by a parsing thread (TurtleFileParser),
+ *  - ZIP and tar archives are parsed member by member by several threads (TurtleArchiveParser).
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "Dice/rdf-parser/TurtleArchiveParser.hpp"
+#include "Dice/rdf-parser/TurtleFileParser.hpp"
+#include "Dice/rdf-parser/TurtleMmapParser.hpp"
+#include "Dice/rdf-parser/TurtleStringParser.hpp"
+#include "Dice/rdf-parser/internal/util/Archive.hpp"
+#include "Dice/rdf-parser/internal/util/Compression.hpp"
+
+namespace Dice::rdf_parser {
+
+	enum struct InputStrategy {
+		// decide by the size and the type of the file
+		Automatic,
+		// read the whole file into a string and parse it at once
+		String,
+		// map the file into memory and parse it while it is iterated
+		Mmap,
+		// stream the file in a parsing thread
+		Stream,
+		// parse the members of a ZIP or tar archive with several threads
+		Archive
+	};
+
+	struct OpenOptions {
+		InputStrategy strategy = InputStrategy::Automatic;
+		// regular files up to this size are read into a string
+		std::size_t string_limit = 16 * 1024 * 1024;
+		// regular files up to this size are mapped into memory, larger ones are streamed
+		std::size_t mmap_limit = std::size_t(4) * 1024 * 1024 * 1024;
+		// queue capacities of the TurtleFileParser, see its constructor
+		std::size_t queue_capacity = internal::Turtle::Configurations::RdfConcurrentStreamParser_QueueCapacity;
+		std::size_t queue_capacity_lower_threshold = internal::Turtle::Configurations::RdfConcurrentStreamParser_QueueCapacity / 10;
+	};
+
+	namespace internal {
+		inline std::string readFile(const std::filesystem::path &path, std::size_t size) {
+			std::string content(size, '\0');
+			std::ifstream file{path, std::ios::binary};
+			file.read(content.data(), static_cast<std::streamsize>(size));
+			content.resize(static_cast<std::size_t>(file.gcount()));
+			return content;
+		}
+
+		inline bool isArchive(const std::filesystem::path &path) {
+			// the tar signature is at byte 257 of the first header
+			return util::detectArchive(readFile(path, 512)) != util::ArchiveFormat::None;
+		}
+	}// namespace internal
+
+	/**
+	 * Parser returned by open(). It forwards to the parser of the chosen strategy.
+	 */
+	class AnyTurtleParser : public internal::Turtle::Parsers::AbstractParser<AnyTurtleParser, false> {
+		using Triple = Dice::rdf::Triple;
+
+		std::variant<std::unique_ptr<TurtleStringParser>,
+					 std::unique_ptr<TurtleMmapParser>,
+					 std::unique_ptr<Turtle::parsers::TurtleFileParser>,
+					 std::unique_ptr<TurtleArchiveParser>>
+				parser_;
+		InputStrategy strategy_;
+
+	public:
+		using Iterator = internal::Turtle::Parsers::Iterator<AnyTurtleParser, false>;
+
+		template<typename Parser>
+		AnyTurtleParser(std::unique_ptr<Parser> parser, InputStrategy strategy) : parser_{std::move(parser)}, strategy_{strategy} {}
+
+		/**
+		 * @return the strategy that was chosen for the input
+		 */
+		[[nodiscard]] InputStrategy strategy() const noexcept { return strategy_; }
+
+		[[nodiscard]] const ParserStatistics &statistics_impl() const noexcept {
+			return std::visit([](const auto &parser) -> const ParserStatistics & { return parser->statistics(); }, parser_);
+		}
+
+		bool hasNextTriple_impl() {
+			return std::visit([](auto &parser) { return parser->hasNextTriple(); }, parser_);
+		}
+
+		void nextTriple_impl() {
+			std::visit([this](auto &parser) {
+				parser->nextTriple();
+				this->current_triple = parser->takeCurrentTriple();
+			},
+					   parser_);
+		}
+
+		/**
+		 * Appends up to max_size triples to batch.
+		 * @return number of triples added; 0 if the parser is exhausted
+		 */
+		std::size_t nextBatch(std::vector<Triple> &batch, std::size_t max_size) {
+			std::size_t added = 0;
+			while (added < max_size and hasNextTriple()) {
+				nextTriple();
+				batch.push_back(this->takeCurrentTriple());
+				++added;
+			}
+			return added;
+		}
+
+		Iterator begin_impl() {
+			return Iterator(this);
+		}
+
+		// the progress reporter reads the statistics of the forwarded parser, so it is stopped before that is destroyed
+		~AnyTurtleParser() override {
+			stopReportingProgress();
+		}
+	};
+
+	/**
+	 * Opens an rdf file (turtle or ntriples) with the strategy that fits its size and type best.
+	 * @param path the file to parse
+	 * @param options thresholds and parser settings
+	 * @return parser for the file
+	 */
+	inline std::unique_ptr<AnyTurtleParser> open(const std::filesystem::path &path, const OpenOptions &options = {}) {
+		struct stat info {};
+		if (::stat(path.c_str(), &info) != 0)
+			throw std::runtime_error{fmt::format("Cannot open {}: {}", path.string(), std::strerror(errno))};
+
+		InputStrategy strategy = options.strategy;
+		if (strategy == InputStrategy::Automatic) {
+			const auto size = static_cast<std::size_t>(info.st_size);
+			if (not S_ISREG(info.st_mode))
+				// pipes, fifos and devices can only be streamed
+				strategy = InputStrategy::Stream;
+			else if (internal::util::detectCompression(path) != Compression::None)
+				// compressed files are decompressed by the stream parser while parsing
+				strategy = InputStrategy::Stream;
+			else if (internal::isArchive(path))
+				strategy = InputStrategy::Archive;
+			else if (size <= options.string_limit)
+				strategy = InputStrategy::String;
+			else if (size <= options.mmap_limit)
+				strategy = InputStrategy::Mmap;
+			else
+				strategy = InputStrategy::Stream;
+		}
+
+		switch (strategy) {
+			case InputStrategy::String:
+				return std::make_unique<AnyTurtleParser>(
+						std::make_unique<TurtleStringParser>(internal::readFile(path, static_cast<std::size_t>(info.st_size))), strategy);
+			case InputStrategy::Mmap:
+				return std::make_unique<AnyTurtleParser>(std::make_unique<TurtleMmapParser>(path), strategy);
+			case InputStrategy::Archive:
+				return std::make_unique<AnyTurtleParser>(std::make_unique<TurtleArchiveParser>(path), strategy);
+			default:
+				return std::make_unique<AnyTurtleParser>(
+						std::make_unique<Turtle::parsers::TurtleFileParser>(path.string(), options.queue_capacity, options.queue_capacity_lower_threshold),
+						InputStrategy::Stream);
+		}
+	}
+}// namespace Dice::rdf_parser
+
+#endif//RDF_PARSER_OPEN_HPP
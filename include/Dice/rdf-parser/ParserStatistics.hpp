@@ -0,0 +1,235 @@
+#ifndef RDF_PARSER_PARSERSTATISTICS_HPP
+#define RDF_PARSER_PARSERSTATISTICS_HPP
+
+/**
+ * ParserStatistics counts what a parser has done so far. Every parser has one; it is updated while the parser runs and
+ * may be read from any thread at any time, e.g. to export it to a monitoring system.
+ *
+ * The time of the parsing thread is split into grammar, actions, reading the input, and waiting for the consumer to take
+ * triples from a full queue. The time of the consumer waiting for the parser is counted as well. If the parser waits for
+ * the consumer most of the time, the load is consumer-bound; if the consumer waits for the parser, it is parser-bound.
+ * Grammar and action times are only measured if RDF_PARSER_TIME_ACTIONS is defined (cmake option RDF_PARSER_TIME_ACTIONS),
+ * as it adds a hook to every action; otherwise they stay 0. Even then only every 64th statement is timed and the times are
+ * extrapolated.
+ *
+ * ProgressReporter calls a callback periodically with a snapshot of the statistics, including an estimate of the time left.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace Dice::rdf_parser {
+
+	/**
+	 * A snapshot of ParserStatistics.
+	 */
+	struct ParserProgress {
+		// bytes of the document that were parsed; for compressed files these are decompressed bytes
+		std::uint64_t bytes_consumed = 0;
+		// size of the document if it is known in advance, otherwise 0
+		std::uint64_t bytes_total = 0;
+		std::uint64_t statements = 0;
+		std::uint64_t triples = 0;
+		// statements that are @prefix, @base, PREFIX or BASE directives
+		std::uint64_t directives = 0;
+		// time spent matching the grammar and in actions, extrapolated from the timed statements; 0 without RDF_PARSER_TIME_ACTIONS
+		std::uint64_t grammar_nanoseconds = 0;
+		std::uint64_t action_nanoseconds = 0;
+		// time the parser waited because the consumer did not take triples from a full queue
+		std::uint64_t blocked_on_full_queue_nanoseconds = 0;
+		// time the consumer waited for the parser because no triples were ready
+		std::uint64_t waiting_for_triples_nanoseconds = 0;
+		// number and time of reads that refilled the input buffer
+		std::uint64_t refills = 0;
+		std::uint64_t refill_nanoseconds = 0;
+		// time since the parser was created, up to the end of the parse
+		std::chrono::nanoseconds elapsed{0};
+		bool done = false;
+
+		/**
+		 * @return the part of the document that was parsed, if its size is known
+		 */
+		[[nodiscard]] std::optional<double> fraction() const noexcept {
+			if (bytes_total == 0)
+				return std::nullopt;
+			return std::min(static_cast<double>(bytes_consumed) / static_cast<double>(bytes_total), 1.0);
+		}
+
+		[[nodiscard]] double bytesPerSecond() const noexcept {
+			return elapsed.count() == 0 ? 0.0 : static_cast<double>(bytes_consumed) * 1e9 / static_cast<double>(elapsed.count());
+		}
+
+		[[nodiscard]] double triplesPerSecond() const noexcept {
+			return elapsed.count() == 0 ? 0.0 : static_cast<double>(triples) * 1e9 / static_cast<double>(elapsed.count());
+		}
+
+		/**
+		 * @return the time left at the average rate so far, if the size of the document is known
+		 */
+		[[nodiscard]] std::optional<std::chrono::seconds> eta() const noexcept {
+			if (done)
+				return std::chrono::seconds{0};
+			const double rate = bytesPerSecond();
+			if (bytes_total == 0 or rate == 0.0)
+				return std::nullopt;
+			const auto left = static_cast<double>(bytes_total - std::min(bytes_consumed, bytes_total));
+			return std::chrono::seconds{static_cast<std::chrono::seconds::rep>(left / rate)};
+		}
+	};
+
+	class ParserStatistics {
+		using clock = std::chrono::steady_clock;
+
+		clock::time_point started_ = clock::now();
+		// nanoseconds from started_ to the end of the parse; -1 while it is running
+		std::atomic<std::int64_t> finished_after_{-1};
+
+	public:
+		std::atomic<std::uint64_t> bytes_consumed{0};
+		std::atomic<std::uint64_t> bytes_total{0};
+		std::atomic<std::uint64_t> statements{0};
+		std::atomic<std::uint64_t> triples{0};
+		std::atomic<std::uint64_t> directives{0};
+		std::atomic<std::uint64_t> grammar_nanoseconds{0};
+		std::atomic<std::uint64_t> action_nanoseconds{0};
+		std::atomic<std::uint64_t> blocked_on_full_queue_nanoseconds{0};
+		std::atomic<std::uint64_t> waiting_for_triples_nanoseconds{0};
+		std::atomic<std::uint64_t> refills{0};
+		std::atomic<std::uint64_t> refill_nanoseconds{0};
+
+		ParserStatistics() = default;
+
+		ParserStatistics(const ParserStatistics &) = delete;
+
+		ParserStatistics &operator=(const ParserStatistics &) = delete;
+
+		/**
+		 * Marks the end of the parse. Only the first call counts.
+		 */
+		void finish() noexcept {
+			std::int64_t running = -1;
+			finished_after_.compare_exchange_strong(running, std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - started_).count());
+		}
+
+		[[nodiscard]] bool finished() const noexcept {
+			return finished_after_.load(std::memory_order_acquire) >= 0;
+		}
+
+		[[nodiscard]] ParserProgress snapshot() const noexcept {
+			constexpr auto relaxed = std::memory_order_relaxed;
+			ParserProgress progress;
+			const std::int64_t finished_after = finished_after_.load(std::memory_order_acquire);
+			progress.done = finished_after >= 0;
+			progress.elapsed = progress.done ? std::chrono::nanoseconds{finished_after}
+											 : std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - started_);
+			progress.bytes_consumed = bytes_consumed.load(relaxed);
+			progress.bytes_total = bytes_total.load(relaxed);
+			progress.statements = statements.load(relaxed);
+			progress.triples = triples.load(relaxed);
+			progress.directives = directives.load(relaxed);
+			progress.grammar_nanoseconds = grammar_nanoseconds.load(relaxed);
+			progress.action_nanoseconds = action_nanoseconds.load(relaxed);
+			progress.blocked_on_full_queue_nanoseconds = blocked_on_full_queue_nanoseconds.load(relaxed);
+			progress.waiting_for_triples_nanoseconds = waiting_for_triples_nanoseconds.load(relaxed);
+			progress.refills = refills.load(relaxed);
+			progress.refill_nanoseconds = refill_nanoseconds.load(relaxed);
+			return progress;
+		}
+	};
+
+	/**
+	 * Calls a callback with a snapshot of the statistics every interval, in a thread of its own, and a last time when the
+	 * parse is done. The statistics must outlive the reporter; it is stopped when it is destroyed.
+	 */
+	class ProgressReporter {
+		const ParserStatistics &statistics_;
+		std::chrono::milliseconds interval_;
+		std::function<void(const ParserProgress &)> callback_;
+		std::mutex m_;
+		std::condition_variable cv_;
+		bool stopped_ = false;
+		std::thread thread_;
+
+		void run() {
+			std::unique_lock<std::mutex> lk(m_);
+			for (;;) {
+				cv_.wait_for(lk, interval_, [&] { return stopped_; });
+				if (stopped_)
+					return;
+				const auto progress = statistics_.snapshot();
+				lk.unlock();
+				try {
+					callback_(progress);
+				} catch (...) {
+					// a failing callback ends the reporting, not the parse
+					return;
+				}
+				if (progress.done)
+					return;
+				lk.lock();
+			}
+		}
+
+	public:
+		/**
+		 * @param statistics e.g. parser.statistics()
+		 * @param interval time between two calls of the callback
+		 * @param callback called in the thread of the reporter
+		 */
+		ProgressReporter(const ParserStatistics &statistics, std::chrono::milliseconds interval,
+						 std::function<void(const ParserProgress &)> callback)
+			: statistics_{statistics},
+			  interval_{std::max(interval, std::chrono::milliseconds{1})},
+			  callback_{std::move(callback)},
+			  thread_{&ProgressReporter::run, this} {}
+
+		ProgressReporter(const ProgressReporter &) = delete;
+
+		ProgressReporter &operator=(const ProgressReporter &) = delete;
+
+		~ProgressReporter() {
+			{
+				std::lock_guard<std::mutex> lk(m_);
+				stopped_ = true;
+			}
+			cv_.notify_one();
+			thread_.join();
+		}
+	};
+
+	namespace internal::util {
+		/**
+		 * Adds the time of its scope to a counter. Nothing is measured if the counter is null.
+		 */
+		class ScopedNanoseconds {
+			std::atomic<std::uint64_t> *counter_;
+			std::chrono::steady_clock::time_point start_;
+
+		public:
+			explicit ScopedNanoseconds(std::atomic<std::uint64_t> *counter) noexcept : counter_{counter} {
+				if (counter_ != nullptr)
+					start_ = std::chrono::steady_clock::now();
+			}
+
+			ScopedNanoseconds(const ScopedNanoseconds &) = delete;
+
+			ScopedNanoseconds &operator=(const ScopedNanoseconds &) = delete;
+
+			~ScopedNanoseconds() {
+				if (counter_ != nullptr)
+					counter_->fetch_add(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count()),
+										std::memory_order_relaxed);
+			}
+		};
+	}// namespace internal::util
+}// namespace Dice::rdf_parser
+
+#endif//RDF_PARSER_PARSERSTATISTICS_HPP
@@ -0,0 +1,166 @@
+#ifndef RDF_PARSER_SAMPLE_HPP
+#define RDF_PARSER_SAMPLE_HPP
+
+/**
+ * sample() estimates the content of a large file without parsing all of it. It maps the file, seeks to random offsets,
+ * resynchronizes to the next statement boundary and parses a short window of whole statements from there.
+ * Windows are parsed with the prefixes and base declared at the begin of the file. A window that runs into a syntax error,
+ * e.g. a prefix that is declared later, ends there and is reported as failed.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <sys/mman.h>
+
+#include <robin_hood.h>
+
+#include "Dice/rdf-parser/internal/Turtle/Actions/Actions.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Control.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Parsers/StatementBoundary.hpp"
+#include "Dice/rdf-parser/internal/Turtle/States/StatementContext.hpp"
+#include "Dice/rdf-parser/internal/Turtle/States/VectorState.hpp"
+#include "Dice/rdf-parser/internal/util/Compression.hpp"
+#include "Dice/rdf-parser/internal/util/FileMapping.hpp"
+
+namespace Dice::rdf_parser {
+
+	struct SampleOptions {
+		// maximal number of triples in the sample
+		std::size_t sample_size = 1000;
+		// number of random offsets to parse from
+		std::size_t windows = 64;
+		// bytes parsed from every offset; the last statement of a window is completed
+		std::size_t window_size = 64 * 1024;
+		// prefixes and base are collected from directives within this many bytes at the begin of the file
+		std::size_t header_size = 1024 * 1024;
+		// seed of the random offsets and of the sample; a random seed if not set
+		std::optional<std::uint64_t> seed;
+	};
+
+	struct Sample {
+		// uniform sample of the parsed triples
+		std::vector<Dice::rdf::Triple> triples;
+		std::size_t bytes_parsed = 0;
+		std::size_t triples_parsed = 0;
+		// windows that ended at a syntax error, e.g. a prefix that is declared after header_size.
+		// Only the statements before the error are counted, so many failed windows make the estimates unreliable.
+		std::size_t failed_windows = 0;
+		double triples_per_byte = 0;
+		// triples_per_byte extrapolated to the size of the file
+		std::size_t estimated_triples = 0;
+		// identifiers of the predicates with their share of the parsed triples, most frequent first
+		std::vector<std::pair<std::string, double>> predicate_distribution;
+	};
+
+	/**
+	 * Samples an uncompressed N-Triples or Turtle file. Files that fit into the windows are parsed completely.
+	 * Generated blank node labels are unique within the sample but differ from those of a full parse.
+	 * @param path a regular, uncompressed file
+	 * @param options size of the sample and of the parsed windows
+	 * @return the sample and estimates derived from the parsed windows
+	 */
+	inline Sample sample(const std::filesystem::path &path, const SampleOptions &options = {}) {
+		namespace Grammar = internal::Turtle::Grammar;
+		namespace Actions = internal::Turtle::Actions;
+		namespace Parsers = internal::Turtle::Parsers;
+		namespace States = internal::Turtle::States;
+		using Input = tao::pegtl::memory_input<tao::pegtl::tracking_mode::lazy, tao::pegtl::eol::lf_crlf, const char *>;
+
+		if (internal::util::detectCompression(path) != Compression::None)
+			throw std::invalid_argument{"sampling needs random access, " + path.string() + " is compressed"};
+		internal::util::FileMapping mapping{path};
+		mapping.advise(MADV_RANDOM);
+		const std::string_view document{mapping.data(), mapping.size()};
+
+		States::StatementContext header;
+		Parsers::collectDirectives(document, 0, std::min(document.size(), options.header_size), header);
+
+		std::mt19937_64 random{options.seed ? *options.seed : std::random_device{}()};
+		std::size_t window_size = options.window_size;
+		std::vector<std::size_t> offsets;
+		if (options.windows == 0 or document.size() <= options.windows * options.window_size) {
+			offsets.push_back(0);
+			window_size = document.size();
+		} else {
+			std::uniform_int_distribution<std::size_t> offset_distribution(0, document.size() - 1);
+			for (std::size_t i = 0; i < options.windows; ++i)
+				offsets.push_back(offset_distribution(random));
+			std::sort(offsets.begin(), offsets.end());
+		}
+
+		Sample result;
+		robin_hood::unordered_map<std::string, std::size_t> predicate_counts;
+		std::vector<Dice::rdf::Triple> triples;
+		// end of the last window; it is a statement boundary, too
+		std::size_t covered = 0;
+		for (const std::size_t offset : offsets) {
+			const std::size_t begin = offset <= covered ? covered : Parsers::nextStatementBoundary(document, offset);
+			if (begin >= document.size())
+				continue;
+			// labels start at the offset, so blank nodes of different windows do not collide
+			States::StatementContext context = header;
+			context.blank_node_label = begin + 1;
+			States::VectorState<false> state;
+			context.applyTo(state);
+			triples.clear();
+			state.setOutput(triples);
+
+			Input in(document.data() + begin, document.data() + document.size(), path.string());
+			std::size_t end = begin;
+			std::size_t complete_triples = 0;
+			try {
+				while (end - begin < window_size) {
+					tao::pegtl::parse<Grammar::ignored>(in);
+					if (in.empty())
+						break;
+					if (not tao::pegtl::parse<Grammar::statement, Actions::action, internal::Turtle::control>(in, state)) {
+						++result.failed_windows;
+						break;
+					}
+					end = static_cast<std::size_t>(in.current() - document.data());
+					complete_triples = triples.size();
+				}
+			} catch (const tao::pegtl::parse_error &) {
+				// a syntax error ends the window
+				++result.failed_windows;
+			}
+			covered = std::max(covered, end);
+			result.bytes_parsed += end - begin;
+
+			for (std::size_t i = 0; i < complete_triples; ++i) {
+				++predicate_counts[triples[i].predicate().getIdentifier()];
+				// reservoir sampling keeps every parsed triple with the same probability
+				++result.triples_parsed;
+				if (result.triples.size() < options.sample_size) {
+					result.triples.push_back(std::move(triples[i]));
+				} else {
+					const std::size_t j = std::uniform_int_distribution<std::size_t>(0, result.triples_parsed - 1)(random);
+					if (j < options.sample_size)
+						result.triples[j] = std::move(triples[i]);
+				}
+			}
+		}
+
+		if (result.bytes_parsed != 0) {
+			result.triples_per_byte = static_cast<double>(result.triples_parsed) / static_cast<double>(result.bytes_parsed);
+			result.estimated_triples = static_cast<std::size_t>(result.triples_per_byte * static_cast<double>(document.size()) + 0.5);
+		}
+		for (auto &[predicate, count] : predicate_counts)
+			result.predicate_distribution.emplace_back(predicate, static_cast<double>(count) / static_cast<double>(result.triples_parsed));
+		std::sort(result.predicate_distribution.begin(), result.predicate_distribution.end(),
+				  [](const auto &a, const auto &b) { return a.second > b.second or (a.second == b.second and a.first < b.first); });
+		return result;
+	}
+}// namespace Dice::rdf_parser
+
+#endif//RDF_PARSER_SAMPLE_HPP
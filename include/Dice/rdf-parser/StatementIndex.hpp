@@ -0,0 +1,281 @@
+#ifndef RDF_PARSER_STATEMENTINDEX_HPP
+#define RDF_PARSER_STATEMENTINDEX_HPP
+
+/**
+ * A StatementIndex records exact statement boundaries of a file at regular intervals, together with the prefixes,
+ * the base and the blank node counter at each of them. It is built by one sequential parse and stored in a sidecar file
+ * next to the document. Later parses of the unchanged file split it at these boundaries without searching for them,
+ * need not scan for directives and produce the same blank node labels as a sequential parse.
+ *
+ * The sidecar is only used if the size and modification time of the file match and a checksum over the first and last
+ * 64 KiB and 4 KiB at every boundary is unchanged.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <sys/mman.h>
+#include <zlib.h>
+
+#include "Dice/rdf-parser/exception/RDFParsingExecption.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Actions/Actions.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Control.hpp"
+#include "Dice/rdf-parser/internal/Turtle/States/StatementContext.hpp"
+#include "Dice/rdf-parser/internal/Turtle/States/VectorState.hpp"
+#include "Dice/rdf-parser/internal/util/BinaryFormat.hpp"
+#include "Dice/rdf-parser/internal/util/FileMapping.hpp"
+#include "Dice/rdf-parser/internal/util/ParseErrors.hpp"
+
+namespace Dice::rdf_parser {
+
+	class StatementIndex {
+	public:
+		struct Entry {
+			// a statement starts at the first non-ignored byte at or after offset
+			std::size_t offset = 0;
+			// number of statements before offset
+			std::size_t statement = 0;
+			internal::Turtle::States::StatementContext context;
+		};
+
+	private:
+		using Input = tao::pegtl::memory_input<tao::pegtl::tracking_mode::lazy, tao::pegtl::eol::lf_crlf, const char *>;
+
+		// version 2 stores redefined prefixes; sidecars of version 1 may miss them and are rebuilt
+		static constexpr std::string_view magic = "RDFPIDX2";
+		static constexpr std::size_t checksum_edge = 64 * 1024;
+		static constexpr std::size_t checksum_block = 4 * 1024;
+
+		std::size_t file_size_ = 0;
+		std::int64_t modified_ = 0;
+		std::uint32_t checksum_ = 0;
+		std::size_t interval_ = 0;
+		std::size_t statements_ = 0;
+		std::vector<Entry> entries_;
+
+		static std::int64_t modificationTime(const std::filesystem::path &path) {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::filesystem::last_write_time(path).time_since_epoch()).count();
+		}
+
+		static std::uint32_t checksum(std::string_view document, const std::vector<Entry> &entries) {
+			uLong crc = crc32(0, nullptr, 0);
+			auto add = [&](std::size_t begin, std::size_t length) {
+				begin = std::min(begin, document.size());
+				length = std::min(length, document.size() - begin);
+				crc = crc32(crc, reinterpret_cast<const Bytef *>(document.data() + begin), static_cast<uInt>(length));
+			};
+			add(0, checksum_edge);
+			add(document.size() - std::min(document.size(), checksum_edge), checksum_edge);
+			for (const auto &entry : entries)
+				add(entry.offset, checksum_block);
+			return static_cast<std::uint32_t>(crc);
+		}
+
+	public:
+		/**
+		 * Default interval between two entries.
+		 */
+		static constexpr std::size_t default_interval = 64 * 1024 * 1024;
+
+		/**
+		 * @return the sidecar file of a document: its path with ".idx" appended
+		 */
+		static std::filesystem::path sidecarPath(const std::filesystem::path &path) {
+			auto sidecar = path;
+			sidecar += ".idx";
+			return sidecar;
+		}
+
+		/**
+		 * Parses the file once and records a boundary at least every interval bytes.
+		 * @throws exception::RDFParsingException if the file is not valid
+		 */
+		static StatementIndex build(const std::filesystem::path &path, std::size_t interval = default_interval) {
+			namespace Grammar = internal::Turtle::Grammar;
+			namespace Actions = internal::Turtle::Actions;
+			namespace States = internal::Turtle::States;
+			internal::util::FileMapping mapping{path};
+			mapping.advise(MADV_SEQUENTIAL);
+			const std::string_view document{mapping.data(), mapping.size()};
+
+			StatementIndex index;
+			index.file_size_ = document.size();
+			index.modified_ = modificationTime(path);
+			index.interval_ = std::max<std::size_t>(interval, 1);
+
+			States::VectorState<false> state;
+			std::vector<Dice::rdf::Triple> triples;
+			state.setOutput(triples);
+			Input in(document.data(), document.data() + document.size(), path.string());
+			std::size_t next_entry = 0;
+			try {
+				for (;;) {
+					const auto offset = static_cast<std::size_t>(in.current() - document.data());
+					if (offset >= next_entry) {
+						index.entries_.push_back({offset, index.statements_, States::StatementContext::of(state)});
+						next_entry = offset + index.interval_;
+					}
+					tao::pegtl::parse<Grammar::ignored>(in);
+					if (in.empty())
+						break;
+					if (not tao::pegtl::parse<Grammar::statement, Actions::action, internal::Turtle::control>(in, state))
+						throw tao::pegtl::parse_error("invalid statement", in);
+					triples.clear();
+					++index.statements_;
+				}
+			} catch (const tao::pegtl::parse_error &e) {
+				throw internal::util::fromParseError(e, document);
+			}
+			index.checksum_ = checksum(document, index.entries_);
+			return index;
+		}
+
+		/**
+		 * Reads the sidecar of a file.
+		 * @return the index; std::nullopt if there is no sidecar, it is truncated or corrupt, or the file changed since it was written
+		 */
+		static std::optional<StatementIndex> load(const std::filesystem::path &path) {
+			std::ifstream in{sidecarPath(path), std::ios::binary};
+			if (not in)
+				return std::nullopt;
+			std::string header(magic.size(), '\0');
+			in.read(header.data(), static_cast<std::streamsize>(header.size()));
+			if (header != magic)
+				return std::nullopt;
+
+			StatementIndex index;
+			index.file_size_ = internal::util::readNumber(in);
+			index.modified_ = static_cast<std::int64_t>(internal::util::readNumber(in));
+			index.checksum_ = static_cast<std::uint32_t>(internal::util::readNumber(in));
+			index.interval_ = internal::util::readNumber(in);
+			index.statements_ = internal::util::readNumber(in);
+			const auto entries = internal::util::readNumber(in);
+			if (not in or index.file_size_ != std::filesystem::file_size(path) or index.modified_ != modificationTime(path))
+				return std::nullopt;
+
+			internal::Turtle::States::StatementContext context;
+			try {
+				for (std::uint64_t i = 0; i < entries; ++i) {
+					Entry entry;
+					entry.offset = internal::util::readNumber(in);
+					entry.statement = internal::util::readNumber(in);
+					context.blank_node_label = internal::util::readNumber(in);
+					context.base = internal::util::readString(in);
+					// prefixes are never removed, so every entry stores the ones added or redefined since the previous entry
+					const auto changed = internal::util::readNumber(in);
+					for (std::uint64_t j = 0; j < changed and in; ++j) {
+						auto prefix = internal::util::readString(in);
+						context.prefixes.insert_or_assign(std::move(prefix), internal::util::readString(in));
+					}
+					if (not in or entry.offset > index.file_size_)
+						return std::nullopt;
+					entry.context = context;
+					index.entries_.push_back(std::move(entry));
+				}
+			} catch (const std::runtime_error &) {
+				// a string length read from a truncated or corrupt sidecar
+				return std::nullopt;
+			}
+
+			internal::util::FileMapping mapping{path};
+			if (checksum({mapping.data(), mapping.size()}, index.entries_) != index.checksum_)
+				return std::nullopt;
+			return index;
+		}
+
+		/**
+		 * @return the index from the sidecar if it is up to date; otherwise a new index, which is written to the sidecar
+		 */
+		static StatementIndex loadOrBuild(const std::filesystem::path &path, std::size_t interval = default_interval) {
+			if (auto index = load(path))
+				return std::move(*index);
+			auto index = build(path, interval);
+			index.save(path);
+			return index;
+		}
+
+		/**
+		 * Writes the sidecar of the file the index was built for.
+		 */
+		void save(const std::filesystem::path &path) const {
+			const auto sidecar = sidecarPath(path);
+			auto temporary = sidecar;
+			temporary += ".tmp";
+			{
+				std::ofstream out{temporary, std::ios::binary | std::ios::trunc};
+				out.write(magic.data(), static_cast<std::streamsize>(magic.size()));
+				internal::util::writeNumber(out, file_size_);
+				internal::util::writeNumber(out, static_cast<std::uint64_t>(modified_));
+				internal::util::writeNumber(out, checksum_);
+				internal::util::writeNumber(out, interval_);
+				internal::util::writeNumber(out, statements_);
+				internal::util::writeNumber(out, entries_.size());
+				const internal::Turtle::States::StatementContext *previous = nullptr;
+				for (const auto &entry : entries_) {
+					internal::util::writeNumber(out, entry.offset);
+					internal::util::writeNumber(out, entry.statement);
+					internal::util::writeNumber(out, entry.context.blank_node_label);
+					internal::util::writeString(out, entry.context.base);
+					std::vector<std::pair<std::string, std::string>> changed;
+					for (const auto &pair : entry.context.prefixes) {
+						if (previous != nullptr) {
+							if (auto found = previous->prefixes.find(pair.first); found != previous->prefixes.end() and found->second == pair.second)
+								continue;
+						}
+						changed.emplace_back(pair.first, pair.second);
+					}
+					internal::util::writeNumber(out, changed.size());
+					for (const auto &[prefix, value] : changed) {
+						internal::util::writeString(out, prefix);
+						internal::util::writeString(out, value);
+					}
+					previous = &entry.context;
+				}
+				if (not out)
+					throw std::runtime_error{"Cannot write " + temporary.string()};
+			}
+			// readers never see a partially written sidecar
+			std::filesystem::rename(temporary, sidecar);
+		}
+
+		[[nodiscard]] const std::vector<Entry> &entries() const noexcept { return entries_; }
+
+		/**
+		 * @return number of statements of the file, directives included
+		 */
+		[[nodiscard]] std::size_t statements() const noexcept { return statements_; }
+
+		[[nodiscard]] std::size_t fileSize() const noexcept { return file_size_; }
+
+		/**
+		 * @return the first entry at or after offset; nullptr if there is none
+		 */
+		[[nodiscard]] const Entry *entryAtOrAfter(std::size_t offset) const noexcept {
+			const auto it = std::lower_bound(entries_.begin(), entries_.end(), offset,
+											 [](const Entry &entry, std::size_t value) { return entry.offset < value; });
+			return it == entries_.end() ? nullptr : &*it;
+		}
+
+		/**
+		 * @return the last entry before the statement with the given number
+		 */
+		[[nodiscard]] const Entry &entryBeforeStatement(std::size_t statement) const {
+			if (entries_.empty())
+				throw std::logic_error{"empty statement index"};
+			const auto it = std::upper_bound(entries_.begin(), entries_.end(), statement,
+											 [](std::size_t value, const Entry &entry) { return value < entry.statement; });
+			return *std::prev(it);
+		}
+	};
+}// namespace Dice::rdf_parser
+
+#endif//RDF_PARSER_STATEMENTINDEX_HPP
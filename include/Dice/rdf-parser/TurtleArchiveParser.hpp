@@ -0,0 +1,248 @@
+#ifndef RDF_PARSER_TURTLEARCHIVEPARSER_HPP
+#define RDF_PARSER_TURTLEARCHIVEPARSER_HPP
+
+/**
+ * ArchiveParser parses all documents in a ZIP or tar archive without extracting them to disk.
+ * The archive is mapped into memory. Stored members are parsed in place, deflated members are inflated into memory first.
+ * Every member is an independent document (with its own prefixes) and is parsed by one of several worker threads.
+ * The triples of all members are merged into one stream. Triples of one member keep their order; members interleave.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Dice/rdf-parser/InputSource.hpp"
+#include "Dice/rdf-parser/ParserStatistics.hpp"
+#include "Dice/rdf-parser/exception/RDFParsingExecption.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Actions/Actions.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Control.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Parsers/AbstractParser.hpp"
+#include "Dice/rdf-parser/internal/Turtle/States/BatchState.hpp"
+#include "Dice/rdf-parser/internal/util/Archive.hpp"
+#include "Dice/rdf-parser/internal/util/FileMapping.hpp"
+
+namespace Dice::rdf_parser {
+
+	class TurtleArchiveParser : public internal::Turtle::Parsers::AbstractParser<TurtleArchiveParser, false> {
+		using Triple = Dice::rdf::Triple;
+		using Batch = internal::Turtle::States::BatchState<false>::Batch;
+
+		// thrown in workers when the parser is destroyed or another worker failed
+		struct Stopped {};
+
+		std::optional<internal::util::FileMapping> mapping_;
+		// content of non-contiguous sources
+		std::string owned_;
+		std::string_view archive_;
+		std::vector<internal::util::ArchiveMember> members_;
+		std::atomic<std::size_t> next_member_{0};
+		std::size_t batch_size_;
+		std::size_t max_batches_;
+
+		std::mutex m;
+		std::condition_variable batch_ready;
+		std::condition_variable batch_taken;
+		std::deque<Batch> batches_;
+		std::size_t running_workers_ = 0;
+		std::exception_ptr error_;
+		bool stopped_ = false;
+
+		Batch current_batch_;
+		std::size_t current_pos_ = 0;
+		std::vector<std::thread> workers_;
+
+		void publish(Batch &&batch) {
+			{
+				std::unique_lock<std::mutex> lk(m);
+				internal::util::ScopedNanoseconds blocked{&statistics_.blocked_on_full_queue_nanoseconds};
+				batch_taken.wait(lk, [&] { return stopped_ or batches_.size() < max_batches_; });
+				if (stopped_)
+					throw Stopped{};
+				batches_.push_back(std::move(batch));
+			}
+			batch_ready.notify_one();
+		}
+
+		void parseMember(const internal::util::ArchiveMember &member, std::string_view document) {
+			namespace Grammar = internal::Turtle::Grammar;
+			namespace Actions = internal::Turtle::Actions;
+			internal::Turtle::States::BatchState<false> state(batch_size_, [this](Batch &&batch) { publish(std::move(batch)); });
+			// the statistics are shared by all workers
+			state.recordStatistics(statistics_);
+			tao::pegtl::memory_input<tao::pegtl::tracking_mode::lazy> input(document.data(), document.size(), member.name);
+			try {
+				tao::pegtl::parse<Grammar::grammar<false>, Actions::action, internal::Turtle::control>(input, state);
+			} catch (const tao::pegtl::parse_error &e) {
+				if (e.positions().empty())
+					throw exception::RDFParsingException(member.name + ": " + e.what());
+				throw exception::RDFParsingException::at(document, e.positions().front().byte, member.name + ": " + e.what());
+			}
+		}
+
+		void work() {
+			std::string inflated;
+			try {
+				for (std::size_t i = next_member_++; i < members_.size(); i = next_member_++) {
+					const auto &member = members_[i];
+					std::string_view document = member.data;
+					if (member.method == internal::util::ArchiveMember::Method::Deflated) {
+						internal::util::inflateMember(member, inflated);
+						document = inflated;
+					}
+					parseMember(member, document);
+				}
+			} catch (const Stopped &) {
+			} catch (const exception::RDFParsingException &) {
+				fail(std::current_exception());
+			} catch (const std::exception &e) {
+				fail(std::make_exception_ptr(exception::RDFParsingException(e.what())));
+			}
+			{
+				std::lock_guard<std::mutex> lk(m);
+				if (--running_workers_ == 0)
+					statistics_.finish();
+			}
+			batch_ready.notify_all();
+		}
+
+		void fail(std::exception_ptr error) {
+			{
+				std::lock_guard<std::mutex> lk(m);
+				if (not error_)
+					error_ = std::move(error);
+				stopped_ = true;
+			}
+			batch_taken.notify_all();
+		}
+
+		void start(const std::string &name, const std::function<bool(const std::string &)> &member_filter, std::size_t threads) {
+			const auto format = internal::util::detectArchive(archive_);
+			if (format == internal::util::ArchiveFormat::None)
+				throw std::invalid_argument{name + " is neither a ZIP nor a tar archive"};
+			members_ = internal::util::listArchiveMembers(archive_, format);
+			if (member_filter)
+				members_.erase(std::remove_if(members_.begin(), members_.end(), [&](const auto &member) { return not member_filter(member.name); }),
+							   members_.end());
+			std::uint64_t bytes_total = 0;
+			for (const auto &member : members_)
+				bytes_total += member.size;
+			statistics_.bytes_total.store(bytes_total, std::memory_order_relaxed);
+			if (threads == 0)
+				threads = std::max(std::thread::hardware_concurrency(), 1u);
+			threads = std::min(threads, std::max<std::size_t>(members_.size(), 1));
+			running_workers_ = threads;
+			workers_.reserve(threads);
+			for (std::size_t i = 0; i < threads; ++i)
+				workers_.emplace_back(&TurtleArchiveParser::work, this);
+		}
+
+	public:
+		using Iterator = internal::Turtle::Parsers::Iterator<TurtleArchiveParser, false>;
+
+		/**
+		 * Opens the archive and starts parsing its members.
+		 * @param path a ZIP or tar archive
+		 * @param member_filter selects the members to parse by their name; all regular files by default
+		 * @param threads number of worker threads; 0 uses one per hardware thread
+		 * @param batch_size triples handed over from a worker at once
+		 * @param max_batches batches parsed ahead of the consumer
+		 */
+		explicit TurtleArchiveParser(const std::filesystem::path &path,
+									 const std::function<bool(const std::string &)> &member_filter = {},
+									 std::size_t threads = 0,
+									 std::size_t batch_size = 10'000,
+									 std::size_t max_batches = 64)
+			: mapping_{std::in_place, path},
+			  archive_{mapping_->data(), mapping_->size()},
+			  batch_size_{std::max<std::size_t>(batch_size, 1)},
+			  max_batches_{std::max<std::size_t>(max_batches, 1)} {
+			start(path.string(), member_filter, threads);
+		}
+
+		/**
+		 * Parses an archive from a source. Contiguous sources are used in place; others are read into memory first,
+		 * as the members of an archive are located from its end.
+		 * @param source e.g. sources::Memory or sources::Stdin
+		 */
+		template<InputSource Source>
+		explicit TurtleArchiveParser(Source source,
+									 const std::function<bool(const std::string &)> &member_filter = {},
+									 std::size_t threads = 0,
+									 std::size_t batch_size = 10'000,
+									 std::size_t max_batches = 64)
+			: batch_size_{std::max<std::size_t>(batch_size, 1)},
+			  max_batches_{std::max<std::size_t>(max_batches, 1)} {
+			if constexpr (ContiguousInputSource<Source>) {
+				archive_ = source.contiguous();
+			} else {
+				owned_ = internal::util::readAll(source);
+				archive_ = owned_;
+			}
+			start(source.name(), member_filter, threads);
+		}
+
+		~TurtleArchiveParser() override {
+			{
+				std::lock_guard<std::mutex> lk(m);
+				stopped_ = true;
+			}
+			batch_taken.notify_all();
+			for (auto &worker : workers_)
+				worker.join();
+		}
+
+		/**
+		 * @return the names of the members that are parsed
+		 */
+		[[nodiscard]] std::vector<std::string> memberNames() const {
+			std::vector<std::string> names;
+			names.reserve(members_.size());
+			for (const auto &member : members_)
+				names.push_back(member.name);
+			return names;
+		}
+
+		bool hasNextTriple_impl() {
+			if (current_pos_ < current_batch_.size())
+				return true;
+			std::unique_lock<std::mutex> lk(m);
+			{
+				internal::util::ScopedNanoseconds waiting{&statistics_.waiting_for_triples_nanoseconds};
+				batch_ready.wait(lk, [&] { return not batches_.empty() or running_workers_ == 0; });
+			}
+			if (batches_.empty()) {
+				if (error_)
+					std::rethrow_exception(error_);
+				return false;
+			}
+			current_batch_ = std::move(batches_.front());
+			batches_.pop_front();
+			current_pos_ = 0;
+			lk.unlock();
+			batch_taken.notify_one();
+			return true;
+		}
+
+		void nextTriple_impl() {
+			this->current_triple = std::move(current_batch_[current_pos_++]);
+		}
+
+		Iterator begin_impl() {
+			return Iterator(this);
+		}
+	};
+}// namespace Dice::rdf_parser
+
+#endif//RDF_PARSER_TURTLEARCHIVEPARSER_HPP
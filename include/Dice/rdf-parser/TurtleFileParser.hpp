@@ -7,22 +7,81 @@
  * It is also responsible for synchronizing between the parsing thread and the triples queue
  * It parse a file as a stream and put the parsed triples increasingly in a tbb::concurrent_bounded_queue
  * It is the best choice for very large files or stream sources.
+ * Files compressed with gzip, bzip2, xz or zstd are detected by their magic bytes and decompressed while parsing.
+ * Multi-member gzip (BGZF) and multi-frame zstd files are decompressed by several threads.
+ * The parsing thread stops between two statements when the parser is cancelled, reaches its limit or is destroyed.
+ * Uncompressed files can be parsed with checkpoints, and a later parser can resume from one of them.
+ * Errors of the parsing thread are rethrown to the consumer after the triples that were parsed before them.
+ * Invalid statements can be skipped and logged instead of ending the parse.
+ * In follow mode, a file that is appended to is parsed like tail -f: at its end the parser waits for new lines until it is cancelled.
+ * statistics() tells whether the parsing thread waits for the consumer or the consumer for the parsing thread.
  */
 
+#include <algorithm>
+#include <atomic>
 #include <exception>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
 #include <thread>
 #include <utility>
 
+#include "Dice/rdf-parser/CancellationToken.hpp"
+#include "Dice/rdf-parser/Checkpoint.hpp"
+#include "Dice/rdf-parser/ErrorLog.hpp"
+#include "Dice/rdf-parser/InputSource.hpp"
+#include "Dice/rdf-parser/ParserStatistics.hpp"
 #include "Dice/rdf-parser/exception/RDFParsingExecption.hpp"
 #include "Dice/rdf-parser/internal/Turtle/Actions/Actions.hpp"
 #include "Dice/rdf-parser/internal/Turtle/Configurations.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Control.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Inputs/FileDescriptorReader.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Inputs/FollowingFileReader.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Inputs/GrowingBufferInput.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Inputs/ParallelDecompressingReader.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Inputs/ReadAheadReader.hpp"
 #include "Dice/rdf-parser/internal/Turtle/Parsers/AbstractParser.hpp"
 #include "Dice/rdf-parser/internal/Turtle/States/ConcurrentState.hpp"
 #include "Dice/rdf-parser/internal/exception//InternalError.hpp"
+#include "Dice/rdf-parser/internal/util/Compression.hpp"
+#include "Dice/rdf-parser/internal/util/ParseErrors.hpp"
 #include "Dice/rdf-parser/internal/util/ScopedThread.hpp"
 
+namespace Dice::rdf_parser {
+
+	/**
+	 * Selects follow mode in the constructors of TurtleFileParser: at the end of the file the parser waits for appended
+	 * lines instead of ending, until it is cancelled or destroyed.
+	 */
+	struct Follow {
+		explicit Follow() = default;
+	};
+
+	inline constexpr Follow follow{};
+
+	/**
+	 * Options of a TurtleFileParser. They are fixed before its parsing thread starts.
+	 */
+	struct FileParserOptions {
+		// maximum number of entries which are cached. When the capacity is reached processing stops.
+		std::size_t queue_capacity = internal::Turtle::Configurations::RdfConcurrentStreamParser_QueueCapacity;
+		// after queue_capacity was reached, processing starts again when the queue reached this length
+		std::size_t queue_capacity_lower_threshold = internal::Turtle::Configurations::RdfConcurrentStreamParser_QueueCapacity / 10;
+		// skip invalid statements instead of failing: the parsing continues after the next '.' at the end of a line.
+		// The errors are recorded in errors(). Triples of an invalid statement are not returned.
+		bool recover_from_errors = false;
+		// number of errors that are kept with their position; all errors are counted
+		std::size_t max_logged_errors = 1000;
+		// a checkpoint is recorded every time at least this many bytes of the file were parsed;
+		// 0 records checkpoints only on request (see TurtleFileParser::requestCheckpoint)
+		std::size_t checkpoint_interval = 0;
+	};
+}// namespace Dice::rdf_parser
+
 namespace Dice::rdf_parser::Turtle::parsers {
 
 	/*
@@ -40,7 +99,6 @@ namespace Dice::rdf_parser::Turtle::parsers {
 		size_t upperThreshold;
 		size_t lowerThreshold;
 
-		std::ifstream stream;
 		std::condition_variable cv;
 		std::mutex m;
 		std::condition_variable cv2;
@@ -48,47 +106,258 @@ namespace Dice::rdf_parser::Turtle::parsers {
 		std::atomic_bool termCountWithinThresholds;
 		std::atomic_bool termsCountIsNotEmpty;
 		std::atomic_bool parsingIsDone;
+		CancellationToken cancellation_;
+		std::atomic_size_t limit_{std::numeric_limits<std::size_t>::max()};
+		// triples handed out to the consumer
+		std::size_t delivered_ = 0;
+		internal::Turtle::States::CheckpointLog checkpoints_;
+		bool follow_ = false;
+		bool recover_ = false;
+		ErrorLog errors_;
+		// set by the parsing thread before parsingIsDone if the parsing failed
+		std::exception_ptr error_;
 		std::unique_ptr<internal::util::ScopedThread> parsingThread;
 
+		/**
+		 * Wakes the parsing thread if it waits for the consumer, so it notices a cancellation or a new limit.
+		 */
+		void wakeParsingThread() {
+			{
+				std::lock_guard<std::mutex> lk(m);
+				termCountWithinThresholds = true;
+			}
+			cv.notify_one();
+		}
+
+		/**
+		 * Hands an error of the parsing thread over to the consumer. It is rethrown by hasNextTriple after the triples
+		 * that were parsed before the error.
+		 */
+		void fail(std::exception_ptr error) noexcept {
+			statistics_.finish();
+			error_ = std::move(error);
+			parsingIsDone = true;
+			{
+				std::lock_guard<std::mutex> lk(m2);
+				termsCountIsNotEmpty = true;
+			}
+			cv2.notify_one();
+		}
+
+		/**
+		 * Called by the consumer when all triples were taken and the parsing is done.
+		 * @throws the error that ended the parsing, if any
+		 */
+		bool noMoreTriples() const {
+			if (error_)
+				std::rethrow_exception(error_);
+			return false;
+		}
+
+		/**
+		 * Checks that the parse can resume from the checkpoint before the parsing thread is started.
+		 */
+		static const Checkpoint &resumable(const std::string &filename, const Checkpoint &checkpoint, bool follow = false) {
+			if (checkpoint.offset == 0 and not follow)
+				return checkpoint;
+			if (not std::filesystem::is_regular_file(filename))
+				throw std::invalid_argument{"only regular files can be resumed or followed: " + filename};
+			if (follow and internal::util::detectCompression(filename) != Compression::None)
+				throw std::invalid_argument{"compressed files cannot be followed: " + filename};
+			if (internal::util::detectCompression(filename) != Compression::None)
+				throw std::invalid_argument{"compressed files cannot be resumed, as they cannot be read from an offset: " + filename};
+			if (checkpoint.offset > std::filesystem::file_size(filename))
+				throw std::invalid_argument{"the checkpoint lies beyond the end of " + filename};
+			return checkpoint;
+		}
+
+		/**
+		 * Parses the document statement by statement, so an invalid statement can be skipped if errors are recovered from.
+		 */
+		template<typename Input, typename State>
+		void parseStatements(Input &input, State &state) {
+			namespace Grammar = internal::Turtle::Grammar;
+			namespace Actions = internal::Turtle::Actions;
+			for (;;) {
+				tao::pegtl::parse<Grammar::ignored>(input);
+				if (input.empty())
+					return;
+				try {
+					// a statement that does not match fails at its begin, like the grammar of the whole document
+					if (not tao::pegtl::parse<Grammar::statement, Actions::action, internal::Turtle::control>(input, state))
+						tao::pegtl::parse<tao::pegtl::must<tao::pegtl::eof>>(input);
+				} catch (const tao::pegtl::parse_error &e) {
+					if (not recover_ or cancellation_.cancelled())
+						throw;
+					errors_.add(logEntry(e));
+					state.discardInvalidStatement();
+					skipInvalidStatement(input, e);
+				}
+			}
+		}
+
+		exception::RDFParsingException logEntry(const tao::pegtl::parse_error &e) const {
+			if (e.positions().empty())
+				return exception::RDFParsingException{e.what()};
+			const auto &position = e.positions().front();
+			return {e.what(), checkpoints_.start().offset + position.byte, position.line, position.column, {}};
+		}
+
+		/**
+		 * Moves the input behind the error and on to the end of the invalid statement.
+		 */
+		template<typename Input>
+		static void skipInvalidStatement(Input &input, const tao::pegtl::parse_error &e) {
+			// the input was rewound to the begin of the statement
+			if (not e.positions().empty() and e.positions().front().byte > input.byte()) {
+				const std::size_t distance = e.positions().front().byte - input.byte();
+				input.bump(std::min(distance, input.size(distance)));
+			}
+			tao::pegtl::parse<internal::Turtle::Grammar::skipStatement>(input);
+			input.discard();
+		}
+
 	public:
 		using Iterator = internal::Turtle::Parsers::Iterator<TurtleFileParser, false>;
-		void startParsing(std::string filename, std::size_t bufferSize) {
-			namespace Grammar = internal::Turtle::Grammar;
+		template<typename Input>
+		void parseInput(Input &input) {
 			namespace States = internal::Turtle::States;
-			namespace Actions = internal::Turtle::Actions;
+			States::ConcurrentState<false>
+					state(parsedTerms,
+						  upperThreshold,
+						  cv, m,
+						  cv2, m2,
+						  termCountWithinThresholds,
+						  termsCountIsNotEmpty,
+						  parsingIsDone,
+						  cancellation_,
+						  limit_,
+						  checkpoints_,
+						  recover_);
+			state.recordStatistics(statistics_);
+			input.recordStatistics(statistics_);
 			try {
+				parseStatements(input, state);
+				// whitespace and comments after the last statement are consumed as well
+				statistics_.bytes_consumed.store(input.byte(), std::memory_order_relaxed);
+				statistics_.finish();
+				state.setParsingIsDone();
+			} catch (const States::ParsingStopped &) {
+				// the rest of the input is not read
+				statistics_.finish();
+				state.setParsingIsDone();
+			} catch (const tao::pegtl::parse_error &) {
+				// a followed file or a pipe ends where it was cancelled, possibly within a statement
+				if (not cancellation_.cancelled())
+					throw;
+				statistics_.finish();
+				state.setParsingIsDone();
+			}
+		}
+
+		void startParsing(std::string filename, std::size_t bufferSize, std::size_t maxBufferSize) {
+			namespace Inputs = internal::Turtle::Inputs;
+			namespace Configurations = internal::Turtle::Configurations;
+			const std::size_t start = checkpoints_.start().offset;
+			auto compression = Compression::None;
+			try {
+				// detecting the compression of a pipe would consume its first bytes
+				if (std::filesystem::is_regular_file(filename)) {
+					compression = internal::util::detectCompression(filename);
+					// the size of a compressed or followed file says nothing about the text that is parsed
+					if (compression == Compression::None and not follow_)
+						statistics_.bytes_total.store(std::filesystem::file_size(filename) - start, std::memory_order_relaxed);
+				}
+				if (follow_) {
+					// no read-ahead, as it would wait for a whole block of appended data
+					Inputs::GrowingBufferInput<Inputs::FollowingFileReader> input(filename, bufferSize, maxBufferSize,
+																				   filename, static_cast<off_t>(start), cancellation_,
+																				   Configurations::RdfConcurrentStreamParser_FollowPollMilliseconds);
+					parseInput(input);
+				} else if (compression == Compression::None) {
+					// reading runs in the read-ahead thread of the input, so the parser does not stall on I/O
+					auto file = std::make_shared<Inputs::FileDescriptorReader>(filename, static_cast<off_t>(start));
+					// a fifo blocks the read-ahead thread until data arrives, so it must notice a cancellation while waiting
+					file->interruptOn(cancellation_, Configurations::RdfConcurrentStreamParser_FollowPollMilliseconds);
+					Inputs::GrowingBufferInput<Inputs::ReadAheadReader> input(filename, bufferSize, maxBufferSize,
+																			   [file](char *buffer, std::size_t length) { return (*file)(buffer, length); },
+																			   Configurations::RdfConcurrentStreamParser_ReadAheadBlockSize,
+																			   Configurations::RdfConcurrentStreamParser_ReadAheadBlocks);
+					parseInput(input);
+				} else if (Inputs::ParallelDecompressingReader::splittable(filename, compression)) {
+					Inputs::GrowingBufferInput<Inputs::ParallelDecompressingReader> input(filename, bufferSize, maxBufferSize,
+																						   filename, compression,
+																						   Configurations::RdfConcurrentStreamParser_DecompressionThreads);
+					parseInput(input);
+				} else {
+					// decompression runs in the read-ahead thread of the input, overlapping with parsing
+					auto decompressed = internal::util::openDecompressingStream(filename, compression);
+					Inputs::GrowingBufferInput<Inputs::ReadAheadReader> input(filename, bufferSize, maxBufferSize,
+																			   Inputs::IstreamReader{*decompressed},
+																			   Configurations::RdfConcurrentStreamParser_ReadAheadBlockSize,
+																			   Configurations::RdfConcurrentStreamParser_ReadAheadBlocks);
+					parseInput(input);
+				}
+			} catch (const tao::pegtl::parse_error &e) {
+				// the stream input tracks positions eagerly, so line and column are already known
+				if (compression == Compression::None and std::filesystem::is_regular_file(filename)) {
+					std::ifstream file{filename, std::ios::binary};
+					fail(std::make_exception_ptr(internal::util::fromParseError(e, file, start)));
+				} else {
+					// pipes and decompressed text cannot be read again for a snippet
+					fail(std::make_exception_ptr(internal::util::fromParseError(e)));
+				}
+			} catch (const exception::RDFParsingException &) {
+				fail(std::current_exception());
+			} catch (const std::exception &e) {
+				fail(std::make_exception_ptr(exception::RDFParsingException(e.what())));
+			} catch (...) {
+				fail(std::current_exception());
+			}
+		}
 
-				States::ConcurrentState<false>
-						state(parsedTerms,
-							  upperThreshold,
-							  cv, m,
-							  cv2, m2,
-							  termCountWithinThresholds,
-							  termsCountIsNotEmpty,
-							  parsingIsDone);
-				tao::pegtl::parse<Grammar::grammar<false>, Actions::action>(
-						tao::pegtl::istream_input(stream, bufferSize, filename), std::move(state));
-			} catch (std::exception &e) {
-				throw exception::RDFParsingException();
+		template<InputSource Source>
+		void startParsingSource(std::shared_ptr<Source> source, std::size_t bufferSize, std::size_t maxBufferSize) {
+			namespace Inputs = internal::Turtle::Inputs;
+			namespace Configurations = internal::Turtle::Configurations;
+			if constexpr (ContiguousInputSource<Source>)
+				statistics_.bytes_total.store(source->contiguous().size(), std::memory_order_relaxed);
+			// a pipe or stdin blocks the read-ahead thread until data arrives, so it must notice a cancellation while waiting
+			if constexpr (InterruptibleInputSource<Source>)
+				source->interruptOn(cancellation_, Configurations::RdfConcurrentStreamParser_FollowPollMilliseconds);
+			try {
+				Inputs::GrowingBufferInput<Inputs::ReadAheadReader> input(source->name(), bufferSize, maxBufferSize,
+																		   [source](char *buffer, std::size_t length) { return source->read(buffer, length); },
+																		   Configurations::RdfConcurrentStreamParser_ReadAheadBlockSize,
+																		   Configurations::RdfConcurrentStreamParser_ReadAheadBlocks);
+				parseInput(input);
+			} catch (const tao::pegtl::parse_error &e) {
+				// a source cannot be read again for a snippet
+				fail(std::make_exception_ptr(internal::util::fromParseError(e)));
+			} catch (const exception::RDFParsingException &) {
+				fail(std::current_exception());
+			} catch (const std::exception &e) {
+				fail(std::make_exception_ptr(exception::RDFParsingException(e.what())));
+			} catch (...) {
+				fail(std::current_exception());
 			}
 		}
 
+		/**
+		 * Stops the parsing thread between two statements and waits for it.
+		 */
 		~TurtleFileParser() override {
-			stream.close();
+			cancellation_.cancel();
+			wakeParsingThread();
 		}
 
+	private:
 		/**
-		 *
-		 * @param filename name of the file to be parsed
-		 * @param queue_capacity maximum number of entries which are cached. When the capacity is reached processing stops.
-		 * @param queue_capacity_lower_threshold after queue_capacity was reach, when queue reached this length, processing starts again.
+		 * Sets the options; the public constructors start the parsing thread afterwards.
 		 */
-		explicit TurtleFileParser(const std::string &filename,
-								  const size_t queue_capacity = internal::Turtle::Configurations::RdfConcurrentStreamParser_QueueCapacity,
-								  const size_t queue_capacity_lower_threshold = internal::Turtle::Configurations::RdfConcurrentStreamParser_QueueCapacity / 10)
-			: stream{filename},
-			  upperThreshold(queue_capacity),
-			  lowerThreshold(queue_capacity_lower_threshold),
+		TurtleFileParser(const FileParserOptions &options, const Checkpoint &start, bool follow)
+			: upperThreshold(options.queue_capacity),
+			  lowerThreshold(options.queue_capacity_lower_threshold),
 			  cv{},
 			  m{},
 			  cv2{},
@@ -96,16 +365,180 @@ namespace Dice::rdf_parser::Turtle::parsers {
 			  termCountWithinThresholds{false},
 			  termsCountIsNotEmpty{false},
 			  parsingIsDone{false},
-			  parsingThread{std::make_unique<internal::util::ScopedThread>(
-					  std::thread(&TurtleFileParser::startParsing, this, filename,
-								  internal::Turtle::Configurations::RdfConcurrentStreamParser_BufferSize))} {
-			if (queue_capacity < queue_capacity_lower_threshold) {
+			  checkpoints_{start},
+			  follow_{follow},
+			  recover_{options.recover_from_errors} {
+			if (options.queue_capacity < options.queue_capacity_lower_threshold) {
 				throw std::logic_error{"queue_capacity_lower_threshold must not be larger than queue_capacity."};
 			}
+			errors_.setMaxEntries(options.max_logged_errors);
+			checkpoints_.every(options.checkpoint_interval);
+		}
+
+		void startThread(const std::string &filename) {
+			parsingThread = std::make_unique<internal::util::ScopedThread>(
+					std::thread(&TurtleFileParser::startParsing, this, filename,
+								internal::Turtle::Configurations::RdfConcurrentStreamParser_BufferSize,
+								internal::Turtle::Configurations::RdfConcurrentStreamParser_MaxBufferSize));
+		}
+
+	public:
+		/**
+		 *
+		 * @param filename name of the file to be parsed
+		 * @param options queue capacity, error recovery and checkpoint interval
+		 */
+		TurtleFileParser(const std::string &filename, const FileParserOptions &options)
+			: TurtleFileParser(options, Checkpoint{}, false) {
+			startThread(filename);
+		}
+
+		/**
+		 *
+		 * @param filename name of the file to be parsed
+		 * @param queue_capacity maximum number of entries which are cached. When the capacity is reached processing stops.
+		 * @param queue_capacity_lower_threshold after queue_capacity was reach, when queue reached this length, processing starts again.
+		 */
+		explicit TurtleFileParser(const std::string &filename,
+								  const size_t queue_capacity = internal::Turtle::Configurations::RdfConcurrentStreamParser_QueueCapacity,
+								  const size_t queue_capacity_lower_threshold = internal::Turtle::Configurations::RdfConcurrentStreamParser_QueueCapacity / 10)
+			: TurtleFileParser(filename, FileParserOptions{.queue_capacity = queue_capacity, .queue_capacity_lower_threshold = queue_capacity_lower_threshold}) {}
+
+		/**
+		 * Resumes parsing a file from a checkpoint. The parse seeks to the offset of the checkpoint and continues with its
+		 * prefixes, base and blank node labels, so it produces the same triples as the original parse after the checkpoint.
+		 * Offsets and triple counts of its own checkpoints continue those of the checkpoint.
+		 * @param filename name of the file to be parsed; it must be the uncompressed file the checkpoint was taken from
+		 * @param checkpoint where to resume
+		 * @param options queue capacity, error recovery and checkpoint interval
+		 */
+		TurtleFileParser(const std::string &filename, const Checkpoint &checkpoint, const FileParserOptions &options)
+			: TurtleFileParser(options, resumable(filename, checkpoint), false) {
+			startThread(filename);
 		}
 
+		/**
+		 * Resumes parsing a file from a checkpoint, see above.
+		 * @param queue_capacity maximum number of entries which are cached. When the capacity is reached processing stops.
+		 * @param queue_capacity_lower_threshold after queue_capacity was reach, when queue reached this length, processing starts again.
+		 */
+		TurtleFileParser(const std::string &filename,
+						 const Checkpoint &checkpoint,
+						 const size_t queue_capacity = internal::Turtle::Configurations::RdfConcurrentStreamParser_QueueCapacity,
+						 const size_t queue_capacity_lower_threshold = internal::Turtle::Configurations::RdfConcurrentStreamParser_QueueCapacity / 10)
+			: TurtleFileParser(filename, checkpoint,
+							   FileParserOptions{.queue_capacity = queue_capacity, .queue_capacity_lower_threshold = queue_capacity_lower_threshold}) {}
+
+		/**
+		 * Follows a file that is appended to, e.g. a log of changes in N-Triples. At the end of the file the parser waits
+		 * for new lines; a line that is still being written is parsed when its newline arrives. Iterating the parser ends
+		 * only when it is cancelled, so cancel it from another thread or stop iterating when done.
+		 * @param filename name of the file to be followed; it must be an uncompressed regular file
+		 * @param checkpoint where to start, e.g. the last checkpoint of a previous run; the begin of the file by default
+		 * @param options queue capacity, error recovery and checkpoint interval
+		 */
+		TurtleFileParser(const std::string &filename, Follow, const Checkpoint &checkpoint, const FileParserOptions &options)
+			: TurtleFileParser(options, resumable(filename, checkpoint, true), true) {
+			startThread(filename);
+		}
+
+		/**
+		 * Follows a file that is appended to, see above.
+		 * @param queue_capacity maximum number of entries which are cached. When the capacity is reached processing stops.
+		 * @param queue_capacity_lower_threshold after queue_capacity was reach, when queue reached this length, processing starts again.
+		 */
+		TurtleFileParser(const std::string &filename,
+						 Follow,
+						 const Checkpoint &checkpoint = {},
+						 const size_t queue_capacity = internal::Turtle::Configurations::RdfConcurrentStreamParser_QueueCapacity,
+						 const size_t queue_capacity_lower_threshold = internal::Turtle::Configurations::RdfConcurrentStreamParser_QueueCapacity / 10)
+			: TurtleFileParser(filename, follow, checkpoint,
+							   FileParserOptions{.queue_capacity = queue_capacity, .queue_capacity_lower_threshold = queue_capacity_lower_threshold}) {}
+
+		/**
+		 *
+		 * @param source the input, e.g. sources::Stdin or sources::FileDescriptor. It is read by a read-ahead thread.
+		 * Cancelling or destroying the parser waits for a read of the source that is in progress, unless the source is
+		 * interruptible like sources::FileDescriptor.
+		 * @param options queue capacity, error recovery and checkpoint interval
+		 */
+		template<InputSource Source>
+		TurtleFileParser(Source source, const FileParserOptions &options)
+			: TurtleFileParser(options, Checkpoint{}, false) {
+			parsingThread = std::make_unique<internal::util::ScopedThread>(
+					std::thread(&TurtleFileParser::startParsingSource<Source>, this, std::make_shared<Source>(std::move(source)),
+								internal::Turtle::Configurations::RdfConcurrentStreamParser_BufferSize,
+								internal::Turtle::Configurations::RdfConcurrentStreamParser_MaxBufferSize));
+		}
+
+		/**
+		 *
+		 * @param source the input, see above
+		 * @param queue_capacity maximum number of entries which are cached. When the capacity is reached processing stops.
+		 * @param queue_capacity_lower_threshold after queue_capacity was reach, when queue reached this length, processing starts again.
+		 */
+		template<InputSource Source>
+		explicit TurtleFileParser(Source source,
+								  const size_t queue_capacity = internal::Turtle::Configurations::RdfConcurrentStreamParser_QueueCapacity,
+								  const size_t queue_capacity_lower_threshold = internal::Turtle::Configurations::RdfConcurrentStreamParser_QueueCapacity / 10)
+			: TurtleFileParser(std::move(source),
+							   FileParserOptions{.queue_capacity = queue_capacity, .queue_capacity_lower_threshold = queue_capacity_lower_threshold}) {}
+
+
+		/**
+		 * Stops the parsing. Triples that are parsed already are not returned anymore.
+		 * The parser can also be cancelled from another thread with cancellationToken().
+		 */
+		void cancel() {
+			cancellation_.cancel();
+			wakeParsingThread();
+		}
+
+		/**
+		 * @return a token that cancels this parser; it may be used from any thread
+		 */
+		[[nodiscard]] CancellationToken cancellationToken() const noexcept {
+			return cancellation_;
+		}
+
+		/**
+		 * Returns at most n triples in total. The parsing thread stops after the statement that contains the n-th triple,
+		 * so a preview of a large file reads only its beginning. Set it right after the construction; the triples that are
+		 * parsed ahead before are bounded by the queue capacity.
+		 */
+		void limit(std::size_t n) {
+			limit_ = n;
+			wakeParsingThread();
+		}
+
+		/**
+		 * Asks the parsing thread to record a checkpoint after the statement it currently parses. It becomes available
+		 * from checkpoint() when the consumer has taken all triples up to it.
+		 */
+		void requestCheckpoint() noexcept {
+			checkpoints_.request();
+		}
+
+		/**
+		 * The checkpoint at the current position of the consumer. Resuming from it yields exactly the triples that were
+		 * not taken yet, so it can be stored in the same transaction as the triples taken so far.
+		 * Checkpoints are only recorded between statements; call this after every triple or batch of triples.
+		 * @return the checkpoint, or nothing if none was recorded right after the triples taken so far
+		 */
+		[[nodiscard]] std::optional<Checkpoint> checkpoint() {
+			return checkpoints_.at(delivered_);
+		}
+
+		/**
+		 * @return the errors of invalid statements that were skipped (see FileParserOptions::recover_from_errors);
+		 * it may be read while the parsing is running
+		 */
+		[[nodiscard]] const ErrorLog &errors() const noexcept {
+			return errors_;
+		}
 
 		void nextTriple_impl() {
+			++delivered_;
 			parsedTerms.pop(this->current_triple);
 			if (parsedTerms.read_available() < lowerThreshold) {
 				{
@@ -117,23 +550,30 @@ namespace Dice::rdf_parser::Turtle::parsers {
 		}
 
 		bool hasNextTriple_impl() {
+			if (delivered_ >= limit_.load(std::memory_order_relaxed) or cancellation_.cancelled())
+				return false;
 			if (parsedTerms.read_available() != 0) {
 				return true;
 			} else {
 
 				//check if the parsing is done
 				if (parsingIsDone) {
-					return false;
+					// the last triples may have been queued after the queue was found empty and before the parsing was done
+					return parsedTerms.read_available() != 0 or noMoreTriples();
 				} else {
 					std::unique_lock<std::mutex> lk(m2);
 					termsCountIsNotEmpty = false;
-					cv2.wait(lk, [&] { return termsCountIsNotEmpty.load(); });
+					{
+						internal::util::ScopedNanoseconds waiting{&statistics_.waiting_for_triples_nanoseconds};
+						// a triple pushed before the flag was cleared did not notify, so the queue itself is checked as well
+						cv2.wait(lk, [&] { return termsCountIsNotEmpty.load() or parsedTerms.read_available() != 0 or parsingIsDone.load(); });
+					}
 
 					if (parsedTerms.read_available() != 0)
 						return true;
 
 					else if (parsingIsDone) {
-						return false;
+						return parsedTerms.read_available() != 0 or noMoreTriples();
 					} else {
 						throw internal::exception::InternalError();
 					}
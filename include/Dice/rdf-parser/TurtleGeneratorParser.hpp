@@ -0,0 +1,71 @@
+#ifndef RDF_PARSER_TURTLEGENERATORPARSER_HPP
+#define RDF_PARSER_TURTLEGENERATORPARSER_HPP
+
+/**
+ * GeneratorParser parses a document in the thread of the consumer, without a background thread or a queue.
+ * Parsing runs in a coroutine that is suspended after every triple and resumed when the next triple is requested,
+ * so only the input buffer and the triples of the current statement are held in memory.
+ * Stopping the iteration early stops the parsing; the rest of the document is never read.
+ */
+
+#include <filesystem>
+#include <utility>
+
+#include "Dice/rdf-parser/InputSource.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Parsers/AbstractParser.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Parsers/StatementGenerator.hpp"
+#include "Dice/rdf-parser/internal/util/Generator.hpp"
+
+namespace Dice::rdf_parser {
+
+	class TurtleGeneratorParser : public internal::Turtle::Parsers::AbstractParser<TurtleGeneratorParser, false> {
+		using Triple = Dice::rdf::Triple;
+
+		internal::util::GeneratorCursor<Triple> cursor_;
+
+	public:
+		using Iterator = internal::Turtle::Parsers::Iterator<TurtleGeneratorParser, false>;
+
+		/**
+		 * Opens a file. Nothing is read before the first triple is requested.
+		 * @param path a file, fifo or device
+		 */
+		explicit TurtleGeneratorParser(const std::filesystem::path &path)
+			: TurtleGeneratorParser(sources::FileDescriptor{path}) {
+			if (std::filesystem::is_regular_file(path))
+				statistics_.bytes_total.store(std::filesystem::file_size(path), std::memory_order_relaxed);
+		}
+
+		/**
+		 * @param source the source is read while the triples are iterated. Contiguous sources are parsed in place.
+		 */
+		template<InputSource Source>
+		explicit TurtleGeneratorParser(Source source)
+			: cursor_{internal::Turtle::Parsers::generateTriplesFromSource(std::move(source), {}, &statistics_)} {}
+
+		~TurtleGeneratorParser() override = default;
+
+		/**
+		 * The triples as a single-pass range. The triples may be moved out of the range.
+		 * Use either this range or the iteration interface of the parser, not both.
+		 * @throws exception::RDFParsingException while iterating when an invalid statement is reached
+		 */
+		internal::util::Generator<Triple> &triples() noexcept {
+			return cursor_.generator();
+		}
+
+		bool hasNextTriple_impl() {
+			return cursor_.hasNext();
+		}
+
+		void nextTriple_impl() {
+			this->current_triple = std::move(cursor_.next());
+		}
+
+		Iterator begin_impl() {
+			return Iterator(this);
+		}
+	};
+}// namespace Dice::rdf_parser
+
+#endif//RDF_PARSER_TURTLEGENERATORPARSER_HPP
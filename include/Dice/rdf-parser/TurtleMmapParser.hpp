@@ -0,0 +1,52 @@
+#ifndef RDF_PARSER_TURTLEMMAPPARSER_HPP
+#define RDF_PARSER_TURTLEMMAPPARSER_HPP
+
+
+/**
+ * MmapParser is responsible for parsing rdf files by mapping them into memory.
+ * It avoids copying the file into a std::string and does not need a parsing thread.
+ * The mapped file is parsed statement by statement while it is iterated, so only the triples of the current statement
+ * are held in memory.
+ */
+
+
+#include <filesystem>
+#include <memory>
+
+#include <sys/mman.h>
+
+#include "Dice/rdf-parser/internal/Turtle/Parsers/BaseStringParser.hpp"
+#include "Dice/rdf-parser/internal/util/FileMapping.hpp"
+
+
+namespace Dice::rdf_parser {
+
+	class TurtleMmapParser : public internal::Turtle::Parsers::BaseStringParser<false> {
+		internal::util::FileMapping mapping_;
+
+	public:
+		using Iterator [[maybe_unused]] = internal::Turtle::Parsers::Iterator<TurtleMmapParser, false>;
+
+		/**
+         * The constructor maps the file. It is parsed while it is iterated.
+         * @param path the file to parse
+         * @throws exception::RDFParsingException while iterating when an invalid statement is reached
+         */
+		explicit TurtleMmapParser(const std::filesystem::path &path) : mapping_{path} {
+			namespace Parsers = internal::Turtle::Parsers;
+			namespace States = internal::Turtle::States;
+			mapping_.advise(MADV_SEQUENTIAL);
+			lazyTerms.emplace(Parsers::generateTriples(
+					std::make_unique<tao::pegtl::memory_input<tao::pegtl::tracking_mode::lazy>>(
+							mapping_.data(), mapping_.data() + mapping_.size(), path.string()),
+					States::StatementContext{}, &this->statistics_));
+		}
+
+		~TurtleMmapParser() override {
+			// the input of the generator points into the mapping
+			lazyTerms.reset();
+		}
+	};
+}// namespace Dice::rdf_parser
+
+#endif//RDF_PARSER_TURTLEMMAPPARSER_HPP
@@ -0,0 +1,204 @@
+#ifndef RDF_PARSER_TURTLEPUSHPARSER_HPP
+#define RDF_PARSER_TURTLEPUSHPARSER_HPP
+
+/**
+ * PushParser parses a document that arrives in chunks of arbitrary size, e.g. from a network connection.
+ * The caller feeds the chunks and gets the triples of all statements that are complete; the incomplete rest is kept
+ * until the next chunk arrives. It needs neither a thread nor a large input buffer, so one thread can serve many
+ * documents at once.
+ *
+ * A statement is complete when it parses and is followed by whitespace or a comment, which ends every token.
+ * Large statements that cannot be parsed yet are retried when the pending input doubled, so they are not parsed
+ * over and over for every small chunk. Errors are therefore only reported at finish() or when the pending input exceeds
+ * the maximal statement size.
+ *
+ * Its statistics count bytes, statements and triples; as statements may be parsed more than once, they are not timed.
+ */
+
+#include <algorithm>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Dice/rdf-parser/ParserStatistics.hpp"
+#include "Dice/rdf-parser/exception/RDFParsingExecption.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Actions/Actions.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Control.hpp"
+#include "Dice/rdf-parser/internal/Turtle/States/VectorState.hpp"
+
+namespace Dice::rdf_parser {
+
+	class TurtlePushParser {
+		using Triple = Dice::rdf::Triple;
+		using Input = tao::pegtl::memory_input<tao::pegtl::tracking_mode::lazy, tao::pegtl::eol::lf_crlf, const char *>;
+
+		// incomplete statements up to this size are retried with every chunk
+		static constexpr std::size_t always_retry_size = 64 * 1024;
+
+		internal::Turtle::States::VectorState<false> state_;
+		std::size_t max_statement_size_;
+		// input that is not parsed yet starts at pos_
+		std::string buffer_;
+		std::size_t pos_ = 0;
+		// pending bytes when parsing failed the last time; 0 if the last statement was complete
+		std::size_t attempted_size_ = 0;
+		bool finished_ = false;
+
+		// position of the begin of buffer_ in the document
+		std::size_t erased_bytes_ = 0;
+		std::size_t erased_lines_ = 0;
+		std::size_t erased_column_ = 0;
+
+		ParserStatistics statistics_;
+
+		static bool endsToken(char c) noexcept {
+			return c == ' ' or c == '\t' or c == '\r' or c == '\n' or c == '#';
+		}
+
+		exception::RDFParsingException errorAt(std::size_t buffer_offset, std::string reason) const {
+			const auto local = exception::RDFParsingException::at(buffer_, buffer_offset, reason);
+			const std::size_t column = local.line() == 1 ? erased_column_ + local.column() : local.column();
+			return {std::move(reason), erased_bytes_ + local.offset(), erased_lines_ + local.line(), column, local.snippet()};
+		}
+
+		void countStatement(std::size_t bytes, std::size_t triples) noexcept {
+			constexpr auto relaxed = std::memory_order_relaxed;
+			statistics_.bytes_consumed.fetch_add(bytes, relaxed);
+			statistics_.statements.fetch_add(1, relaxed);
+			// directives are the only statements without triples
+			if (triples == 0)
+				statistics_.directives.fetch_add(1, relaxed);
+			else
+				statistics_.triples.fetch_add(triples, relaxed);
+		}
+
+		void compact() {
+			const std::string_view erased{buffer_.data(), pos_};
+			erased_bytes_ += pos_;
+			if (const auto last_newline = erased.rfind('\n'); last_newline != std::string_view::npos) {
+				erased_lines_ += static_cast<std::size_t>(std::count(erased.begin(), erased.end(), '\n'));
+				erased_column_ = pos_ - last_newline - 1;
+			} else {
+				erased_column_ += pos_;
+			}
+			buffer_.erase(0, pos_);
+			pos_ = 0;
+		}
+
+		/**
+		 * Parses all complete statements in the buffer.
+		 */
+		void parseStatements(std::vector<Triple> &out) {
+			namespace Grammar = internal::Turtle::Grammar;
+			namespace Actions = internal::Turtle::Actions;
+			state_.setOutput(out);
+			for (;;) {
+				const char *const end = buffer_.data() + buffer_.size();
+				// positions of the input are relative to input_begin
+				const std::size_t input_begin = pos_;
+				Input in(buffer_.data() + input_begin, end, "feed");
+				tao::pegtl::parse<Grammar::ignored>(in);
+				if (in.empty()) {
+					// a comment at the end may still continue
+					if (finished_) {
+						statistics_.bytes_consumed.fetch_add(buffer_.size() - pos_, std::memory_order_relaxed);
+						pos_ = buffer_.size();
+					}
+					attempted_size_ = 0;
+					return;
+				}
+				const auto statement_begin = static_cast<std::size_t>(in.current() - buffer_.data());
+				const std::size_t triples_before = out.size();
+				const std::size_t labels_before = state_.blankNodeLabelCount();
+				std::optional<tao::pegtl::parse_error> error;
+				bool complete = false;
+				try {
+					complete = tao::pegtl::parse<Grammar::statement, Actions::action, internal::Turtle::control>(in, state_);
+				} catch (const tao::pegtl::parse_error &e) {
+					error = e;
+				}
+				// without a delimiter the last token might continue in the next chunk
+				complete = complete and (finished_ or (in.current() != end and endsToken(*in.current())));
+				if (complete) {
+					const auto statement_end = static_cast<std::size_t>(in.current() - buffer_.data());
+					countStatement(statement_end - pos_, out.size() - triples_before);
+					pos_ = statement_end;
+					continue;
+				}
+
+				out.resize(triples_before);
+				state_.discardStatement();
+				state_.resetBlankNodeLabelCount(labels_before);
+				pos_ = statement_begin;
+				const std::size_t pending = buffer_.size() - pos_;
+				if (finished_ or pending > max_statement_size_) {
+					if (error and not error->positions().empty())
+						throw errorAt(input_begin + error->positions().front().byte, error->what());
+					throw errorAt(pos_, finished_ ? "invalid or incomplete statement" : "statement exceeds the maximal statement size");
+				}
+				attempted_size_ = pending;
+				return;
+			}
+		}
+
+	public:
+		/**
+		 * @param max_statement_size the pending input may grow to this size before it is reported as an error
+		 */
+		explicit TurtlePushParser(std::size_t max_statement_size = 64 * 1024 * 1024)
+			: max_statement_size_{max_statement_size} {}
+
+		/**
+		 * Parses the next chunk of the document.
+		 * @param data the chunk; it is copied, so it may be reused after the call
+		 * @param out the triples of all statements completed by this chunk are appended
+		 * @throws exception::RDFParsingException if the pending input exceeds the maximal statement size
+		 */
+		void feed(std::span<const char> data, std::vector<Triple> &out) {
+			if (finished_)
+				throw std::logic_error{"feed() after finish()"};
+			if (pos_ > buffer_.size() / 2)
+				compact();
+			buffer_.append(data.data(), data.size());
+			// retry a large incomplete statement only after the pending input doubled
+			if (attempted_size_ <= always_retry_size or buffer_.size() - pos_ >= 2 * attempted_size_)
+				parseStatements(out);
+		}
+
+		/**
+		 * Ends the document and parses what is left.
+		 * @param out the triples of the remaining statements are appended
+		 * @throws exception::RDFParsingException if the rest is not a complete statement
+		 */
+		void finish(std::vector<Triple> &out) {
+			if (finished_)
+				return;
+			finished_ = true;
+			try {
+				parseStatements(out);
+			} catch (...) {
+				statistics_.finish();
+				throw;
+			}
+			statistics_.finish();
+			buffer_.clear();
+			buffer_.shrink_to_fit();
+			pos_ = 0;
+		}
+
+		/**
+		 * @return number of bytes fed but not yet parsed
+		 */
+		[[nodiscard]] std::size_t pendingBytes() const noexcept { return buffer_.size() - pos_; }
+
+		/**
+		 * @return the statistics of the parse; they may be read from any thread
+		 */
+		[[nodiscard]] const ParserStatistics &statistics() const noexcept { return statistics_; }
+	};
+}// namespace Dice::rdf_parser
+
+#endif//RDF_PARSER_TURTLEPUSHPARSER_HPP
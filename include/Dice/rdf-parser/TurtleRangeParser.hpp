@@ -0,0 +1,227 @@
+#ifndef RDF_PARSER_TURTLERANGEPARSER_HPP
+#define RDF_PARSER_TURTLERANGEPARSER_HPP
+
+/**
+ * RangeParser parses the statements of a byte range of a file, e.g. one shard of a dump that is loaded by several nodes.
+ *
+ * Both ends of the range are moved forward to the next statement boundary (see StatementBoundary.hpp), so a statement
+ * belongs to the range in which its boundary lies. As every range moves its ends the same way, the shards of a file
+ * cover all statements exactly once. Prefixes and base are reconstructed from the directives before the range.
+ * Generated blank node labels start at the offset of the range, so they are unique across the shards of a file; the
+ * union of all shards is the same graph as a sequential parse, up to the names of these blank nodes.
+ *
+ * With a StatementIndex of the file, ranges start and end at the boundaries recorded in the index instead. Neither
+ * boundaries nor directives are searched then, and blank node labels are the same as in a sequential parse.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/mman.h>
+
+#include "Dice/rdf-parser/StatementIndex.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Configurations.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Parsers/AbstractParser.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Parsers/StatementBoundary.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Parsers/StatementGenerator.hpp"
+#include "Dice/rdf-parser/internal/Turtle/States/StatementContext.hpp"
+#include "Dice/rdf-parser/internal/util/FileMapping.hpp"
+#include "Dice/rdf-parser/internal/util/Generator.hpp"
+
+namespace Dice::rdf_parser {
+
+	/**
+	 * Shard index of count equally sized shards.
+	 */
+	struct Shard {
+		std::size_t index;
+		std::size_t count;
+	};
+
+	/**
+	 * Number of a statement in a file, counting from 0. Directives are statements, too.
+	 */
+	struct StatementNumber {
+		std::size_t value;
+	};
+
+	enum struct RangeDirectives {
+		// all directives before the range; the bytes before the range are scanned for them
+		Preceding,
+		// only the directives at the begin of the file, so nothing but the header and the range is read
+		Header
+	};
+
+	class TurtleRangeParser : public internal::Turtle::Parsers::AbstractParser<TurtleRangeParser, false> {
+		using Triple = Dice::rdf::Triple;
+
+		internal::util::FileMapping mapping_;
+		std::size_t begin_ = 0;
+		std::size_t end_ = 0;
+		std::optional<internal::util::GeneratorCursor<Triple>> cursor_;
+
+		void start(const std::filesystem::path &path, std::size_t begin_offset, std::size_t end_offset, RangeDirectives directives) {
+			namespace Parsers = internal::Turtle::Parsers;
+			namespace States = internal::Turtle::States;
+			if (begin_offset > end_offset)
+				throw std::invalid_argument{"the begin of the range is behind its end"};
+			const std::string_view document{mapping_.data(), mapping_.size()};
+			const std::size_t begin = Parsers::nextStatementBoundary(document, std::min(begin_offset, document.size()));
+			const std::size_t end = Parsers::nextStatementBoundary(document, std::min(end_offset, document.size()));
+
+			States::StatementContext context;
+			const std::size_t scan_end = directives == RangeDirectives::Preceding
+												 ? begin
+												 : std::min(begin, internal::Turtle::Configurations::RdfRangeParser_HeaderSize);
+			Parsers::collectDirectives(document, 0, scan_end, context);
+			context.blank_node_label = begin + 1;
+			startAt(path, begin, end, std::move(context));
+		}
+
+		void start(const std::filesystem::path &path, const StatementIndex &index, std::size_t begin_offset, std::size_t end_offset) {
+			checkIndex(index);
+			const auto *begin = index.entryAtOrAfter(begin_offset);
+			const auto *end = index.entryAtOrAfter(end_offset);
+			if (begin == nullptr) {
+				startAt(path, mapping_.size(), mapping_.size(), {});
+				return;
+			}
+			startAt(path, begin->offset, end == nullptr ? mapping_.size() : end->offset, begin->context);
+		}
+
+		void checkIndex(const StatementIndex &index) const {
+			if (index.fileSize() != mapping_.size() or index.entries().empty())
+				throw std::invalid_argument{"the statement index does not belong to the file"};
+		}
+
+		void startAt(const std::filesystem::path &path, std::size_t begin, std::size_t end, internal::Turtle::States::StatementContext context) {
+			begin_ = begin;
+			end_ = std::max(begin, end);
+			mapping_.advise(MADV_SEQUENTIAL);
+			cursor_.emplace(internal::Turtle::Parsers::generateTriples(
+					std::make_unique<tao::pegtl::memory_input<tao::pegtl::tracking_mode::lazy>>(
+							mapping_.data() + begin_, mapping_.data() + end_,
+							path.string() + " from byte " + std::to_string(begin_)),
+					std::move(context), &statistics_));
+		}
+
+		/**
+		 * @return the offset of the shard boundary before shard index
+		 */
+		[[nodiscard]] std::size_t shardOffset(Shard shard, std::size_t index) const {
+			if (shard.count == 0 or shard.index >= shard.count)
+				throw std::invalid_argument{"shard index must be smaller than the shard count"};
+			const std::size_t size = mapping_.size();
+			if (index == shard.count)
+				return size;
+			// offsets are computed from the quotient and the remainder, so the product cannot overflow
+			return size / shard.count * index + size % shard.count * index / shard.count;
+		}
+
+		/**
+		 * Parses statements up to the one with the given number with the context of entry and returns the context there.
+		 */
+		std::size_t skipStatements(const std::filesystem::path &path, const StatementIndex::Entry &entry, std::size_t statement,
+								   internal::Turtle::States::StatementContext &context) const {
+			namespace Grammar = internal::Turtle::Grammar;
+			namespace Actions = internal::Turtle::Actions;
+			namespace States = internal::Turtle::States;
+			States::VectorState<false> state;
+			entry.context.applyTo(state);
+			std::vector<Triple> triples;
+			state.setOutput(triples);
+			const std::string_view document{mapping_.data(), mapping_.size()};
+			tao::pegtl::memory_input<tao::pegtl::tracking_mode::lazy> in(document.data() + entry.offset, document.data() + document.size(), path.string());
+			try {
+				for (std::size_t i = entry.statement; i < statement; ++i) {
+					tao::pegtl::parse<Grammar::ignored>(in);
+					if (in.empty() or not tao::pegtl::parse<Grammar::statement, Actions::action, internal::Turtle::control>(in, state))
+						break;
+					triples.clear();
+				}
+			} catch (const tao::pegtl::parse_error &e) {
+				throw internal::util::fromParseError(e, document.substr(entry.offset));
+			}
+			context = States::StatementContext::of(state);
+			return static_cast<std::size_t>(in.current() - document.data());
+		}
+
+	public:
+		using Iterator = internal::Turtle::Parsers::Iterator<TurtleRangeParser, false>;
+
+		/**
+		 * Parses the statements whose boundary lies in [begin_offset, end_offset).
+		 * @param path a regular, uncompressed file
+		 * @param directives where prefixes and base are taken from
+		 */
+		TurtleRangeParser(const std::filesystem::path &path, std::size_t begin_offset, std::size_t end_offset,
+						  RangeDirectives directives = RangeDirectives::Preceding)
+			: mapping_{path} {
+			start(path, begin_offset, end_offset, directives);
+		}
+
+		/**
+		 * Parses one of shard.count shards of equal size. The shards of a file together contain every statement once.
+		 */
+		TurtleRangeParser(const std::filesystem::path &path, Shard shard, RangeDirectives directives = RangeDirectives::Preceding)
+			: mapping_{path} {
+			start(path, shardOffset(shard, shard.index), shardOffset(shard, shard.index + 1), directives);
+		}
+
+		/**
+		 * Parses one of shard.count shards, cut at the boundaries of the index that follow the equally sized offsets.
+		 * Shards cannot be smaller than the interval of the index.
+		 * @param index an index of the unchanged file, e.g. from StatementIndex::loadOrBuild
+		 */
+		TurtleRangeParser(const std::filesystem::path &path, const StatementIndex &index, Shard shard)
+			: mapping_{path} {
+			start(path, index, shardOffset(shard, shard.index), shardOffset(shard, shard.index + 1));
+		}
+
+		/**
+		 * Parses the file from the statement with the given number to its end. Only the statements since the last entry
+		 * of the index before it are parsed to get there.
+		 */
+		TurtleRangeParser(const std::filesystem::path &path, const StatementIndex &index, StatementNumber first)
+			: mapping_{path} {
+			checkIndex(index);
+			const auto &entry = index.entryBeforeStatement(first.value);
+			internal::Turtle::States::StatementContext context;
+			const std::size_t begin = skipStatements(path, entry, first.value, context);
+			startAt(path, begin, mapping_.size(), std::move(context));
+		}
+
+		~TurtleRangeParser() override = default;
+
+		/**
+		 * @return the offset of the first statement boundary of the range
+		 */
+		[[nodiscard]] std::size_t beginOffset() const noexcept { return begin_; }
+
+		/**
+		 * @return the offset of the first statement boundary after the range
+		 */
+		[[nodiscard]] std::size_t endOffset() const noexcept { return end_; }
+
+		bool hasNextTriple_impl() {
+			return cursor_->hasNext();
+		}
+
+		void nextTriple_impl() {
+			this->current_triple = std::move(cursor_->next());
+		}
+
+		Iterator begin_impl() {
+			return Iterator(this);
+		}
+	};
+}// namespace Dice::rdf_parser
+
+#endif//RDF_PARSER_TURTLERANGEPARSER_HPP
@@ -12,11 +12,22 @@
 #include <utility>
 
 #include "Dice/rdf-parser/internal/Turtle/Actions/Actions.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Control.hpp"
 #include "Dice/rdf-parser/internal/Turtle/Parsers/BaseStringParser.hpp"
 
 
 namespace Dice::rdf_parser {
 
+	/**
+	 * Selects lazy parsing in the constructors of TurtleStringParser: the document is parsed while it is iterated,
+	 * so only the triples of the current statement are held in memory and stopping early skips the rest of the document.
+	 */
+	struct Lazy {
+		explicit Lazy() = default;
+	};
+
+	inline constexpr Lazy lazy{};
+
 	class TurtleStringParser : public internal::Turtle::Parsers::BaseStringParser<false> {
 
 
@@ -30,14 +41,40 @@ namespace Dice::rdf_parser {
          */
 		explicit TurtleStringParser(std::string text) : BaseStringParser<false>(std::move(text)) {}
 
+		/**
+		 * Parses the whole content of a source at once. Contiguous sources (sources::Memory) are parsed without a copy.
+		 * @param source e.g. sources::Stdin or sources::Istream
+		 */
+		template<InputSource Source>
+		explicit TurtleStringParser(Source source) {
+			parseSource(source, {});
+		}
+
+		/**
+		 * Parses the string while it is iterated, e.g. TurtleStringParser parser{text, lazy}.
+		 * @throws exception::RDFParsingException while iterating when an invalid statement is reached
+		 */
+		TurtleStringParser(std::string text, Lazy) {
+			parseLazily(std::move(text), {});
+		}
+
+		/**
+		 * Parses a source while it is iterated. Sources that are not contiguous are read statement by statement.
+		 * @throws exception::RDFParsingException while iterating when an invalid statement is reached
+		 */
+		template<InputSource Source>
+		TurtleStringParser(Source source, Lazy) {
+			parseSourceLazily(std::move(source), {});
+		}
+
 		/**
          * checks whether a string is valid rdf turtle file
          */
 		static bool isParsable(const std::string &input) {
 			namespace Grammar = internal::Turtle::Grammar;
 			try {
-				tao::pegtl::string_input in(input, "the text");
-				tao::pegtl::parse<Grammar::grammar<false>>(in);
+				tao::pegtl::memory_input<tao::pegtl::tracking_mode::lazy> in(input, "the text");
+				tao::pegtl::parse<Grammar::grammar<false>, tao::pegtl::nothing, internal::Turtle::control>(in);
 				return true;
 			} catch (std::exception &e) {
 				return false;
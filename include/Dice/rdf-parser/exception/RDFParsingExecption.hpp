@@ -1,12 +1,106 @@
 #ifndef RDF_PARSER_RDFPARSINGEXECPTION_HPP
 #define RDF_PARSER_RDFPARSINGEXECPTION_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <fmt/format.h>
+
 namespace Dice::rdf_parser::exception {
 	class RDFParsingException : public std::exception {
 	public:
+		static constexpr std::size_t unknown = static_cast<std::size_t>(-1);
+
+	private:
+		std::string reason_;
+		std::size_t offset_ = unknown;
+		std::size_t line_ = unknown;
+		std::size_t column_ = unknown;
+		std::string snippet_;
+		std::string message_;
+
+	public:
+		RDFParsingException() : message_{"The rdf document can't be parsed"} {}
+
+		/**
+		 * @param reason description of the error without position information
+		 */
+		explicit RDFParsingException(std::string reason)
+			: reason_{std::move(reason)},
+			  message_{fmt::format("The rdf document can't be parsed: {}", reason_)} {}
+
+		/**
+		 * @param reason description of the error
+		 * @param offset byte offset of the error from the begin of the document
+		 * @param line line of the error, starting at 1
+		 * @param column byte in line of the error, starting at 1
+		 * @param snippet the part of the document around the error
+		 */
+		RDFParsingException(std::string reason, std::size_t offset, std::size_t line, std::size_t column, std::string snippet)
+			: reason_{std::move(reason)},
+			  offset_{offset},
+			  line_{line},
+			  column_{column},
+			  snippet_{std::move(snippet)},
+			  message_{fmt::format("The rdf document can't be parsed at line {}, column {} (byte {}): {}\n{}",
+								   line_, column_, offset_, reason_, snippet_)} {}
+
+		/**
+		 * Creates an exception for an error in an in-memory document. Line, column and snippet are computed from the offset.
+		 * This is only done on failure, so the parsers can use lazy position tracking.
+		 * @param document the whole document that was parsed
+		 * @param offset byte offset of the error
+		 * @param reason description of the error
+		 */
+		static RDFParsingException at(std::string_view document, std::size_t offset, std::string reason) {
+			offset = std::min(offset, document.size());
+			std::size_t line = 1;
+			std::size_t line_begin = 0;
+			for (std::size_t pos = 0; pos < offset; ++pos) {
+				if (document[pos] == '\n') {
+					++line;
+					line_begin = pos + 1;
+				}
+			}
+			return {std::move(reason), offset, line, offset - line_begin + 1, snippetAt(document.substr(line_begin), offset - line_begin)};
+		}
+
+		/**
+		 * @param line_from_begin text starting at the begin of the line of the error
+		 * @param column_offset offset of the error in that line
+		 * @return up to 80 bytes of the line around the error
+		 */
+		static std::string snippetAt(std::string_view line_from_begin, std::size_t column_offset) {
+			constexpr std::size_t context = 40;
+			std::size_t begin = (column_offset > context) ? column_offset - context : 0;
+			std::string_view snippet = line_from_begin.substr(std::min(begin, line_from_begin.size()), 2 * context);
+			if (auto line_end = snippet.find_first_of("\r\n"); line_end != std::string_view::npos)
+				snippet = snippet.substr(0, line_end);
+			return std::string{snippet};
+		}
+
 		[[nodiscard]] const char *what() const noexcept override {
-			return "The rdf document can't be parsed";
+			return message_.c_str();
 		}
+
+		[[nodiscard]] const std::string &reason() const noexcept { return reason_; }
+
+		/**
+		 * @return byte offset of the error or RDFParsingException::unknown
+		 */
+		[[nodiscard]] std::size_t offset() const noexcept { return offset_; }
+
+		[[nodiscard]] std::size_t line() const noexcept { return line_; }
+
+		[[nodiscard]] std::size_t column() const noexcept { return column_; }
+
+		[[nodiscard]] const std::string &snippet() const noexcept { return snippet_; }
+
+		[[nodiscard]] bool hasPosition() const noexcept { return offset_ != unknown; }
 	};
 }// namespace Dice::rdf_parser::exception
 
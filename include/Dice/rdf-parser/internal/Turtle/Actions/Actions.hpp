@@ -15,6 +15,10 @@ namespace Dice::rdf_parser::internal::Turtle::Actions {
 	struct action<Grammar::statement> {
 		template<typename Input, bool sparqlQuery, class Derived>
 		static void apply(const Input &in, States::State<sparqlQuery, Derived> &state) {
+			// states that record checkpoints need the end of the statement
+			if constexpr (requires(Derived &derived) { derived.statementParsed(in); })
+				static_cast<Derived &>(state).statementParsed(in);
+			state.countStatement(in);
 			state.syncWithMainThread();
 		}
 	};
@@ -126,7 +126,7 @@ namespace Dice::rdf_parser::internal::Turtle::Actions {
 				state.setElement(URIRef(mappedPrefix + statement.substr(pos + 1, statement.length() - prefix.length())));
 				state.setIri_is_IRIREF(false);
 			} else {
-				throw std::runtime_error("undefined prefix");
+				throw tao::pegtl::parse_error(fmt::format("undefined prefix \"{}\"", prefix), in);
 			}
 		};
 	};
@@ -290,11 +290,8 @@ namespace Dice::rdf_parser::internal::Turtle::Actions {
 	struct action<Grammar::turtleString> {
 		template<typename Input, bool SparqlQuery>
 		static void apply(const Input &in, States::BasicState<SparqlQuery> &state) {
-			std::stringstream ss;
-			ss << in.string();
-			std::string s;
-			s = ss.str().substr(1, ss.str().length() - 1 - 1);
-			state.setLiteral_string(std::move(s));
+			// copy the value out of the input buffer once; literals may be huge
+			state.setLiteral_string(std::string(in.begin() + 1, in.end() - 1));
 		}
 	};
 
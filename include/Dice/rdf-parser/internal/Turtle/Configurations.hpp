@@ -1,9 +1,28 @@
 #ifndef RDF_PARSER_CONFIG_HPP
 #define RDF_PARSER_CONFIG_HPP
 
+#include <cstddef>
+
 namespace Dice::rdf_parser::internal::Turtle::Configurations {
-	constexpr std::size_t RdfConcurrentStreamParser_BufferSize = 1024 * 1024 * 128;
+	// initial size of the input buffer. It grows geometrically for larger statements and shrinks back to this size afterwards.
+	constexpr std::size_t RdfConcurrentStreamParser_BufferSize = 1024 * 1024;
+	// address space reserved for the input buffer, i.e. the maximal size of a single statement. Memory is only committed when used.
+	constexpr std::size_t RdfConcurrentStreamParser_MaxBufferSize = std::size_t(1) << 40;
+	// a statement needing a larger buffer, e.g. one with a giant literal, is spilled to a temporary file above this size
+	constexpr std::size_t RdfConcurrentStreamParser_SpillThreshold = 256 * 1024 * 1024;
 	constexpr std::size_t RdfConcurrentStreamParser_QueueCapacity = 100'000;
+	// the input is read by its own thread, which keeps this many blocks of this size ahead of the parser
+	constexpr std::size_t RdfConcurrentStreamParser_ReadAheadBlockSize = 4 * 1024 * 1024;
+	constexpr std::size_t RdfConcurrentStreamParser_ReadAheadBlocks = 4;
+	// threads decompressing multi-member gzip (BGZF) and multi-frame zstd files. 0 uses one per hardware thread.
+	constexpr std::size_t RdfConcurrentStreamParser_DecompressionThreads = 0;
+	// a followed file is checked this often for appended data if inotify is not available, and cancellation is noticed within it.
+	// Pipes and stdin notice a cancellation within it as well.
+	constexpr int RdfConcurrentStreamParser_FollowPollMilliseconds = 100;
+	// range parsers that only read the header take the directives from this many bytes at the begin of the file
+	constexpr std::size_t RdfRangeParser_HeaderSize = 1024 * 1024;
+	// with RDF_PARSER_TIME_ACTIONS, every this many statements one is timed to split the parsing time into grammar and actions
+	constexpr std::size_t ParserStatistics_SampleInterval = 64;
 }// namespace Dice::rdf_parser::internal::Turtle::Configurations
 
 #endif//RDF_PARSER_CONFIG_HPP
@@ -0,0 +1,219 @@
+#ifndef RDF_PARSER_CONTROL_HPP
+#define RDF_PARSER_CONTROL_HPP
+
+/**
+ * The control class passed to tao::pegtl::parse by all parsers.
+ * For more information about control classes please check https://github.com/taocpp/PEGTL/blob/master/doc/Control-and-Debug.md
+ *
+ * By default it is tao::pegtl::normal. If RDF_PARSER_PROFILE_RULES is defined (cmake option RDF_PARSER_PROFILE_RULES)
+ * every rule and action is measured by ProfilingControl. The results can be dumped with
+ * Dice::rdf_parser::internal::util::RuleProfiler::instance().writeText(std::cout) or writeJson(...).
+ * If RDF_PARSER_TIME_ACTIONS is defined (cmake option RDF_PARSER_TIME_ACTIONS), StatisticsControl is layered on top and
+ * times the actions of the statements that a state samples for the grammar and action times of its ParserStatistics.
+ * Statements and triples are counted by the states in either case.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+#include <tao/pegtl.hpp>
+
+#include "Dice/rdf-parser/internal/Turtle/Grammar.hpp"
+
+#ifdef RDF_PARSER_PROFILE_RULES
+#include <algorithm>
+#include <vector>
+
+#include "Dice/rdf-parser/internal/util/InputOffset.hpp"
+#include "Dice/rdf-parser/internal/util/RuleProfiler.hpp"
+#endif
+
+namespace Dice::rdf_parser::internal::Turtle {
+
+#ifdef RDF_PARSER_PROFILE_RULES
+	namespace profiling {
+		using clock = std::chrono::steady_clock;
+
+		struct Frame {
+			std::size_t offset;
+			// furthest offset the rule or one of its sub-rules reached so far
+			std::size_t furthest;
+			clock::time_point start;
+		};
+
+		// rules currently being matched by this thread
+		inline thread_local std::vector<Frame> frames;
+
+		/**
+		 * Pops the frame of the rule that just finished and passes the furthest offset it reached on to the enclosing rule.
+		 * PEGTL rewinds the input of a failed sub-rule before the enclosing rule fails, so the enclosing rule cannot see
+		 * how far its input was read from its own position.
+		 */
+		inline Frame finish(std::size_t offset) {
+			auto frame = frames.back();
+			frames.pop_back();
+			frame.furthest = std::max(frame.furthest, offset);
+			if (not frames.empty())
+				frames.back().furthest = std::max(frames.back().furthest, frame.furthest);
+			return frame;
+		}
+
+		inline uint64_t nanosecondsSince(clock::time_point start) {
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+		}
+	}// namespace profiling
+
+	/**
+	 * Control class recording invocations, successes, failures, consumed bytes, rewound bytes and time per rule.
+	 */
+	template<typename Rule>
+	struct ProfilingControl : tao::pegtl::normal<Rule> {
+		static util::RuleStatistics &statistics() {
+			return util::RuleProfiler::statisticsOf<Rule>();
+		}
+
+		template<typename ParseInput, typename... States>
+		static void start(const ParseInput &in, States &&...) {
+			statistics().invocations.fetch_add(1, std::memory_order_relaxed);
+			auto offset = util::inputOffset(in);
+			profiling::frames.push_back({offset, offset, profiling::clock::now()});
+		}
+
+		template<typename ParseInput, typename... States>
+		static void success(const ParseInput &in, States &&...) {
+			auto frame = profiling::finish(util::inputOffset(in));
+			auto &s = statistics();
+			s.successes.fetch_add(1, std::memory_order_relaxed);
+			s.bytes_consumed.fetch_add(util::inputOffset(in) - frame.offset, std::memory_order_relaxed);
+			s.nanoseconds.fetch_add(profiling::nanosecondsSince(frame.start), std::memory_order_relaxed);
+		}
+
+		template<typename ParseInput, typename... States>
+		static void failure(const ParseInput &in, States &&...) {
+			// sub-rules have usually rewound the input already, so the rewound bytes are those up to the furthest offset reached
+			auto frame = profiling::finish(util::inputOffset(in));
+			auto &s = statistics();
+			s.failures.fetch_add(1, std::memory_order_relaxed);
+			s.bytes_rewound.fetch_add(frame.furthest - frame.offset, std::memory_order_relaxed);
+			s.nanoseconds.fetch_add(profiling::nanosecondsSince(frame.start), std::memory_order_relaxed);
+		}
+
+		template<typename ParseInput, typename... States>
+		static void unwind(const ParseInput &, States &&...) {
+			profiling::frames.pop_back();
+		}
+
+		template<template<typename...> class Action, typename Iterator, typename ParseInput, typename... States>
+		static auto apply(const Iterator &begin, const ParseInput &in, States &&...st)
+				-> decltype(tao::pegtl::normal<Rule>::template apply<Action>(begin, in, st...)) {
+			ActionTimer timer;
+			return tao::pegtl::normal<Rule>::template apply<Action>(begin, in, st...);
+		}
+
+		template<template<typename...> class Action, typename ParseInput, typename... States>
+		static auto apply0(const ParseInput &in, States &&...st)
+				-> decltype(tao::pegtl::normal<Rule>::template apply0<Action>(in, st...)) {
+			ActionTimer timer;
+			return tao::pegtl::normal<Rule>::template apply0<Action>(in, st...);
+		}
+
+	private:
+		struct ActionTimer {
+			profiling::clock::time_point start = profiling::clock::now();
+
+			~ActionTimer() {
+				auto &s = statistics();
+				s.action_invocations.fetch_add(1, std::memory_order_relaxed);
+				s.action_nanoseconds.fetch_add(profiling::nanosecondsSince(start), std::memory_order_relaxed);
+			}
+		};
+	};
+
+#endif
+
+#ifdef RDF_PARSER_TIME_ACTIONS
+	namespace sampling {
+		/**
+		 * Adds the time of an action to the state if the state times the current statement.
+		 */
+		template<typename State>
+		class SampledActionTimer {
+			State *state_ = nullptr;
+			std::chrono::steady_clock::time_point start_;
+
+		public:
+			explicit SampledActionTimer(State &state) {
+				if (state.timingActions()) {
+					state_ = &state;
+					start_ = std::chrono::steady_clock::now();
+				}
+			}
+
+			SampledActionTimer(const SampledActionTimer &) = delete;
+
+			SampledActionTimer &operator=(const SampledActionTimer &) = delete;
+
+			~SampledActionTimer() {
+				if (state_ != nullptr)
+					state_->addActionNanoseconds(static_cast<std::uint64_t>(
+							std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count()));
+			}
+		};
+	}// namespace sampling
+
+	/**
+	 * Control class telling the state when a statement starts and timing the actions of sampled statements.
+	 * The action of the statement itself ends the sample; its own time is dropped when the next sample starts.
+	 */
+	template<typename Rule, typename Base>
+	struct StatisticsControl : Base {
+		template<typename ParseInput, typename... States>
+		static void start(const ParseInput &in, States &&...st) {
+			Base::start(in, st...);
+			if constexpr (std::is_same_v<Rule, Grammar::statement> and sizeof...(States) == 1 and requires { (st.statementStarted(), ...); })
+				(st.statementStarted(), ...);
+		}
+
+		template<template<typename...> class Action, typename Iterator, typename ParseInput, typename... States>
+		static auto apply(const Iterator &begin, const ParseInput &in, States &&...st)
+				-> decltype(Base::template apply<Action>(begin, in, st...)) {
+			if constexpr (sizeof...(States) == 1 and requires { (st.timingActions(), ...); }) {
+				sampling::SampledActionTimer timer{st...};
+				return Base::template apply<Action>(begin, in, st...);
+			} else {
+				return Base::template apply<Action>(begin, in, st...);
+			}
+		}
+
+		template<template<typename...> class Action, typename ParseInput, typename... States>
+		static auto apply0(const ParseInput &in, States &&...st)
+				-> decltype(Base::template apply0<Action>(in, st...)) {
+			if constexpr (sizeof...(States) == 1 and requires { (st.timingActions(), ...); }) {
+				sampling::SampledActionTimer timer{st...};
+				return Base::template apply0<Action>(in, st...);
+			} else {
+				return Base::template apply0<Action>(in, st...);
+			}
+		}
+	};
+#endif
+
+#ifdef RDF_PARSER_PROFILE_RULES
+	template<typename Rule>
+	using BaseControl = ProfilingControl<Rule>;
+#else
+	template<typename Rule>
+	using BaseControl = tao::pegtl::normal<Rule>;
+#endif
+
+#ifdef RDF_PARSER_TIME_ACTIONS
+	template<typename Rule>
+	struct control : StatisticsControl<Rule, BaseControl<Rule>> {};
+#else
+	template<typename Rule>
+	struct control : BaseControl<Rule> {};
+#endif
+}// namespace Dice::rdf_parser::internal::Turtle
+
+#endif//RDF_PARSER_CONTROL_HPP
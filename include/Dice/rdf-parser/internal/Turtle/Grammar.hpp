@@ -211,7 +211,81 @@ namespace Dice::rdf_parser::internal::Turtle::Grammar {
 	struct ignored : star<sor<space, comment>> {
 	};
 
-	struct NumericLiteral : sor<DOUBLE, DECIMAL, INTEGER> {
+	/**
+	 * Equivalent to sor<DOUBLE, DECIMAL, INTEGER>.
+	 * Instead of trying the alternatives one after another (and rescanning the digits for every failed one),
+	 * the literal is classified by a single look-ahead scan and only the matching rule is run.
+	 * The matching rule is still matched through Control so that the actions of DOUBLE, DECIMAL and INTEGER are applied.
+	 */
+	struct NumericLiteral {
+		using rule_t = NumericLiteral;
+		using subs_t = type_list<DOUBLE, DECIMAL, INTEGER>;
+
+		enum class Kind {
+			None,
+			Integer,
+			Decimal,
+			Double
+		};
+
+		template<typename ParseInput>
+		static Kind classify(ParseInput &in) {
+			// returns the byte at offset or 0 if the input ends before
+			auto peek = [&](std::size_t offset) -> char {
+				return (in.size(offset + 1) > offset) ? in.peek_char(offset) : '\0';
+			};
+			auto isDigit = [](char c) { return c >= '0' and c <= '9'; };
+			auto countDigits = [&](std::size_t offset) {
+				std::size_t end = offset;
+				while (isDigit(peek(end)))
+					++end;
+				return end - offset;
+			};
+			auto exponentAt = [&](std::size_t offset) {
+				if (char c = peek(offset); c != 'e' and c != 'E')
+					return false;
+				++offset;
+				if (char c = peek(offset); c == '+' or c == '-')
+					++offset;
+				return isDigit(peek(offset));
+			};
+
+			std::size_t pos = 0;
+			if (char c = peek(pos); c == '+' or c == '-')
+				++pos;
+			const std::size_t integerDigits = countDigits(pos);
+			pos += integerDigits;
+
+			if (peek(pos) == '.') {
+				const std::size_t fractionDigits = countDigits(pos + 1);
+				if ((integerDigits != 0 or fractionDigits != 0) and exponentAt(pos + 1 + fractionDigits))
+					return Kind::Double;
+				if (fractionDigits != 0)
+					return Kind::Decimal;
+			} else if (integerDigits != 0 and exponentAt(pos)) {
+				return Kind::Double;
+			}
+			return (integerDigits != 0) ? Kind::Integer : Kind::None;
+		}
+
+		template<apply_mode A,
+				 rewind_mode M,
+				 template<typename...> class Action,
+				 template<typename...> class Control,
+				 typename ParseInput,
+				 typename... States>
+		[[nodiscard]] static bool match(ParseInput &in, States &&...st) {
+			switch (classify(in)) {
+				case Kind::Double:
+					return Control<DOUBLE>::template match<A, M, Action, Control>(in, st...);
+				case Kind::Decimal:
+					return Control<DECIMAL>::template match<A, M, Action, Control>(in, st...);
+				case Kind::Integer:
+					return Control<INTEGER>::template match<A, M, Action, Control>(in, st...);
+				default:
+					return false;
+			}
+		}
 	};
 
 	struct turtleString
@@ -264,7 +338,17 @@ namespace Dice::rdf_parser::internal::Turtle::Grammar {
 	};
 
 
-	struct term : sor<literal, BlankNode, iri> {
+	/**
+	 * Equivalent to sor<literal, BlankNode, iri>.
+	 * The alternative is picked by the first byte so that e.g. an IRI is not tried against all literal rules first.
+	 * Only 't' and 'f' are ambiguous (BooleanLiteral or PrefixedName); there the original order is kept.
+	 */
+	struct term : if_then_else<at<one<'<'>>, iri,
+							   if_then_else<at<one<'\"', '\''>>, literal,
+											if_then_else<at<one<'_', '['>>, BlankNode,
+														 if_then_else<at<sor<digit, one<'+', '-', '.'>>>, literal,
+																	  if_then_else<at<one<'t', 'f'>>, sor<literal, iri>,
+																				   iri>>>>> {
 	};
 
 	//The following grammars are not part of turtle.they are part of sparql language.but used here to make it
@@ -364,9 +448,14 @@ namespace Dice::rdf_parser::internal::Turtle::Grammar {
 								opt<predicateObjectList<sparqlQuery>>> {
 	};
 
+	/**
+	 * Equivalent to sor<tripleSeq1, tripleSeq2>.
+	 * A blankNodePropertyList always starts with '[', so tripleSeq2 is only tried for triples starting with it.
+	 */
 	template<bool sparqlQuery = false>
-	struct triple : sor<
-							tripleSeq1<sparqlQuery>, tripleSeq2<sparqlQuery>> {
+	struct triple : if_then_else<at<one<'['>>,
+								 sor<tripleSeq1<sparqlQuery>, tripleSeq2<sparqlQuery>>,
+								 tripleSeq1<sparqlQuery>> {
 	};
 
 
@@ -375,9 +464,21 @@ namespace Dice::rdf_parser::internal::Turtle::Grammar {
 									triple<sparqlQuery>, ignored, one<'.'>> {
 	};
 
-	struct statement : sor<
-							   tripleExtended<false>,
-							   directive> {
+	// a triple never starts with '@', so @prefix and @base directives skip the triple rules
+	struct statement : if_then_else<at<one<'@'>>,
+									directive,
+									sor<
+											tripleExtended<false>,
+											directive>> {
+	};
+
+
+	// the end of a statement as it is found when an invalid statement is skipped: a '.' at the end of a line, maybe with a comment
+	struct statementEnd : seq<one<'.'>, star<one<' ', '\t', '\r'>>, sor<one<'\n'>, seq<one<'#'>, until<eolf>>, eof>> {
+	};
+
+	// skips an invalid statement up to the next statementEnd
+	struct skipStatement : until<sor<statementEnd, eof>> {
 	};
 
 
@@ -0,0 +1,131 @@
+#ifndef RDF_PARSER_FILEDESCRIPTORREADER_HPP
+#define RDF_PARSER_FILEDESCRIPTORREADER_HPP
+
+/**
+ * Reader for GrowingBufferInput and ReadAheadReader that reads a file descriptor.
+ * Regular files are read with pread and announced to the kernel as read sequentially, so it reads ahead aggressively.
+ * Pipes, fifos and sockets are read with read. A read of them blocks until data arrives, so they can be made to wait with
+ * poll instead, which notices a CancellationToken within one poll interval (see interruptOn).
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Dice/rdf-parser/CancellationToken.hpp"
+
+namespace Dice::rdf_parser::internal::Turtle::Inputs {
+
+	class FileDescriptorReader {
+		int fd_ = -1;
+		bool owns_ = false;
+		bool seekable_ = true;
+		off_t offset_ = 0;
+		// set by interruptOn for descriptors that are not regular files
+		std::optional<CancellationToken> cancellation_;
+		int poll_milliseconds_ = 0;
+
+		/**
+		 * Waits until the descriptor can be read without blocking.
+		 * @return false if the reader was cancelled while waiting
+		 */
+		bool waitForData() const {
+			pollfd watched{fd_, POLLIN, 0};
+			for (;;) {
+				if (cancellation_->cancelled())
+					return false;
+				// readable, at its end or failed; read tells which
+				if (const int r = ::poll(&watched, 1, poll_milliseconds_); r > 0 or (r < 0 and errno != EINTR))
+					return true;
+			}
+		}
+
+	public:
+		/**
+		 * Opens the file and closes it on destruction.
+		 * @param offset offset in the file to start reading at; must be 0 for fifos and devices
+		 */
+		explicit FileDescriptorReader(const std::filesystem::path &path, off_t offset = 0)
+			: fd_{::open(path.c_str(), O_RDONLY | O_CLOEXEC)}, owns_{true}, offset_{offset} {
+			if (fd_ < 0)
+				throw std::runtime_error{"Cannot open " + path.string() + ": " + std::strerror(errno)};
+			::posix_fadvise(fd_, offset_, 0, POSIX_FADV_SEQUENTIAL);
+		}
+
+		/**
+		 * Reads an open file descriptor from its current offset.
+		 * @param fd the file descriptor
+		 * @param owns whether the file descriptor is closed on destruction
+		 */
+		explicit FileDescriptorReader(int fd, bool owns = false) : fd_{fd}, owns_{owns} {
+			offset_ = ::lseek(fd_, 0, SEEK_CUR);
+			if (offset_ < 0) {
+				seekable_ = false;
+				offset_ = 0;
+			} else {
+				::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+			}
+		}
+
+		FileDescriptorReader(const FileDescriptorReader &) = delete;
+
+		FileDescriptorReader &operator=(const FileDescriptorReader &) = delete;
+
+		FileDescriptorReader(FileDescriptorReader &&other) noexcept
+			: fd_{std::exchange(other.fd_, -1)},
+			  owns_{std::exchange(other.owns_, false)},
+			  seekable_{other.seekable_},
+			  offset_{other.offset_},
+			  cancellation_{std::move(other.cancellation_)},
+			  poll_milliseconds_{other.poll_milliseconds_} {}
+
+		~FileDescriptorReader() {
+			if (owns_)
+				::close(fd_);
+		}
+
+		/**
+		 * Lets reads of a pipe, fifo, socket or terminal return 0 when cancellation is cancelled, instead of blocking
+		 * until the writer sends more data or closes its end. Regular files never block, so nothing changes for them.
+		 * @param cancellation ends the reading; a waiting read returns 0 within one poll interval
+		 * @param poll_milliseconds how long to wait for data before the cancellation is checked again
+		 */
+		void interruptOn(CancellationToken cancellation, int poll_milliseconds) {
+			struct stat status {};
+			if (::fstat(fd_, &status) == 0 and S_ISREG(status.st_mode))
+				return;
+			cancellation_ = std::move(cancellation);
+			poll_milliseconds_ = poll_milliseconds;
+		}
+
+		std::size_t operator()(char *buffer, std::size_t length) {
+			if (cancellation_ and not waitForData())
+				return 0;
+			for (;;) {
+				const ssize_t r = seekable_ ? ::pread(fd_, buffer, length, offset_) : ::read(fd_, buffer, length);
+				if (r >= 0) {
+					offset_ += r;
+					return static_cast<std::size_t>(r);
+				}
+				if (errno == EINTR)
+					continue;
+				if (errno == ESPIPE and seekable_) {
+					seekable_ = false;
+					continue;
+				}
+				throw std::runtime_error{std::string{"error reading the input: "} + std::strerror(errno)};
+			}
+		}
+	};
+}// namespace Dice::rdf_parser::internal::Turtle::Inputs
+
+#endif//RDF_PARSER_FILEDESCRIPTORREADER_HPP
@@ -0,0 +1,132 @@
+#ifndef RDF_PARSER_FOLLOWINGFILEREADER_HPP
+#define RDF_PARSER_FOLLOWINGFILEREADER_HPP
+
+/**
+ * Reader for GrowingBufferInput that follows a file which is appended to, like tail -f.
+ * At the end of the file it waits for new data instead of returning 0. It is woken by inotify; if inotify is not
+ * available, it polls. It returns 0 only when it is cancelled.
+ *
+ * Only complete lines are handed out while waiting at the end of the file: a line that is still being written is held
+ * back until its newline arrives, so the parser never sees half a statement as the end of the input.
+ * Lines that are longer than the requested length are handed out in parts, as the parser needs them to continue anyway.
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Dice/rdf-parser/CancellationToken.hpp"
+
+namespace Dice::rdf_parser::internal::Turtle::Inputs {
+
+	class FollowingFileReader {
+		std::string name_;
+		int fd_ = -1;
+		// -1 if inotify is not available; then the file is polled
+		int inotify_fd_ = -1;
+		off_t offset_ = 0;
+		CancellationToken cancellation_;
+		int poll_milliseconds_;
+
+		std::size_t readSome(char *buffer, std::size_t length) {
+			for (;;) {
+				const ssize_t r = ::pread(fd_, buffer, length, offset_);
+				if (r >= 0)
+					return static_cast<std::size_t>(r);
+				if (errno != EINTR)
+					throw std::runtime_error{"error reading " + name_ + ": " + std::strerror(errno)};
+			}
+		}
+
+		/**
+		 * Waits until the file was modified or the poll interval passed.
+		 */
+		void waitForData() {
+			struct stat status {};
+			if (::fstat(fd_, &status) == 0 and status.st_size < offset_)
+				throw std::runtime_error{name_ + " was truncated while it was followed"};
+			if (inotify_fd_ < 0) {
+				::poll(nullptr, 0, poll_milliseconds_);
+				return;
+			}
+			pollfd watched{inotify_fd_, POLLIN, 0};
+			if (::poll(&watched, 1, poll_milliseconds_) > 0) {
+				// the events themselves are not needed; reading the file again tells what changed
+				alignas(inotify_event) char events[4096];
+				while (::read(inotify_fd_, events, sizeof(events)) > 0) {
+				}
+			}
+		}
+
+	public:
+		/**
+		 * @param path the file to follow
+		 * @param offset offset in the file to start reading at
+		 * @param cancellation ends the following; the reader returns 0 within one poll interval
+		 * @param poll_milliseconds how long to wait for a change before the file is checked again
+		 */
+		FollowingFileReader(const std::filesystem::path &path, off_t offset, CancellationToken cancellation, int poll_milliseconds)
+			: name_{path.string()},
+			  fd_{::open(path.c_str(), O_RDONLY | O_CLOEXEC)},
+			  offset_{offset},
+			  cancellation_{std::move(cancellation)},
+			  poll_milliseconds_{poll_milliseconds} {
+			if (fd_ < 0)
+				throw std::runtime_error{"Cannot open " + name_ + ": " + std::strerror(errno)};
+			inotify_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+			if (inotify_fd_ >= 0 and ::inotify_add_watch(inotify_fd_, path.c_str(), IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE) < 0) {
+				::close(inotify_fd_);
+				inotify_fd_ = -1;
+			}
+		}
+
+		FollowingFileReader(const FollowingFileReader &) = delete;
+
+		FollowingFileReader &operator=(const FollowingFileReader &) = delete;
+
+		FollowingFileReader(FollowingFileReader &&other) noexcept
+			: name_{std::move(other.name_)},
+			  fd_{std::exchange(other.fd_, -1)},
+			  inotify_fd_{std::exchange(other.inotify_fd_, -1)},
+			  offset_{other.offset_},
+			  cancellation_{std::move(other.cancellation_)},
+			  poll_milliseconds_{other.poll_milliseconds_} {}
+
+		~FollowingFileReader() {
+			if (inotify_fd_ >= 0)
+				::close(inotify_fd_);
+			if (fd_ >= 0)
+				::close(fd_);
+		}
+
+		std::size_t operator()(char *buffer, std::size_t length) {
+			for (;;) {
+				if (cancellation_.cancelled())
+					return 0;
+				std::size_t r = readSome(buffer, length);
+				if (r != 0 and r < length) {
+					// the end of the file was reached; keep back a line that is still being written
+					const auto last_newline = std::string_view{buffer, r}.rfind('\n');
+					r = last_newline == std::string_view::npos ? 0 : last_newline + 1;
+				}
+				if (r != 0) {
+					offset_ += static_cast<off_t>(r);
+					return r;
+				}
+				waitForData();
+			}
+		}
+	};
+}// namespace Dice::rdf_parser::internal::Turtle::Inputs
+
+#endif//RDF_PARSER_FOLLOWINGFILEREADER_HPP
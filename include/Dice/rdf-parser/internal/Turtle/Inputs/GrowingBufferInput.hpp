@@ -0,0 +1,308 @@
+#ifndef RDF_PARSER_GROWINGBUFFERINPUT_HPP
+#define RDF_PARSER_GROWINGBUFFERINPUT_HPP
+
+/**
+ * A PEGTL input for streamed sources whose buffer grows with the size of the statement that is parsed.
+ * It follows tao::pegtl::buffer_input, see https://github.com/taocpp/PEGTL/blob/master/doc/Inputs-and-Parsing.md#buffer-inputs
+ *
+ * tao::pegtl::buffer_input allocates its maximal size up front and fails for any statement that does not fit into it.
+ * GrowingBufferInput only reserves address space for the maximal size. The part that is used grows geometrically
+ * when a statement needs it and is given back when the buffer is discarded after the statement.
+ * As the address of the buffer never changes, PEGTL's rewind markers stay valid while the buffer grows.
+ * Buffers are borrowed from util::BufferPool::instance(), which bounds the memory of all buffers together.
+ *
+ * A statement larger than the spill threshold, usually one with a giant literal, does not stay resident: the part of the
+ * buffer above the threshold is mapped to a temporary file (util::SpillFile) while the buffer is that large. Its pages
+ * can be written out by the kernel and are not accounted by the pool.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <tao/pegtl.hpp>
+
+#include "Dice/rdf-parser/ParserStatistics.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Configurations.hpp"
+#include "Dice/rdf-parser/internal/util/BufferPool.hpp"
+#include "Dice/rdf-parser/internal/util/SpillFile.hpp"
+
+namespace Dice::rdf_parser::internal::Turtle::Inputs {
+
+	/**
+	 * @tparam Reader callable std::size_t(char *buffer, std::size_t length) that reads at most length bytes and returns 0 at the end
+	 */
+	template<typename Reader, typename Eol = tao::pegtl::eol::lf_crlf, typename Source = std::string>
+	class GrowingBufferInput {
+	public:
+		using reader_t = Reader;
+		using eol_t = Eol;
+		using source_t = Source;
+		using iterator_t = tao::pegtl::internal::iterator;
+		using action_t = tao::pegtl::internal::action_input<GrowingBufferInput>;
+
+		static constexpr tao::pegtl::tracking_mode tracking_mode_v = tao::pegtl::tracking_mode::eager;
+
+		// minimal number of bytes read at once
+		static constexpr std::size_t chunk_size = 64 * 1024;
+		// the spill threshold is rounded up to a multiple of this, so it is aligned to normal and huge pages
+		static constexpr std::size_t spill_alignment = 2 * 1024 * 1024;
+
+	private:
+		Reader reader_;
+		// bytes of the buffer that may currently be filled. Grows and shrinks geometrically.
+		std::size_t capacity_;
+		std::size_t initial_capacity_;
+		util::BufferPool::Lease buffer_;
+		iterator_t current_;
+		char *end_;
+		Source source_;
+		// refills are counted if set
+		ParserStatistics *statistics_ = nullptr;
+		// the buffer above this offset is mapped to spill_file_ while the capacity exceeds it. 0 never spills.
+		std::size_t spill_threshold_ = 0;
+		util::SpillFile spill_file_;
+		bool spilled_ = false;
+
+		// bytes of the capacity that are anonymous memory and accounted by the pool
+		[[nodiscard]] std::size_t resident(std::size_t capacity) const noexcept {
+			return spilled_ ? std::min(capacity, spill_threshold_) : capacity;
+		}
+
+		/**
+		 * Prepares the buffer for growing to capacity. Crossing the threshold maps the part above it to the spill file;
+		 * if that fails the buffer stays in memory.
+		 * @throws std::runtime_error if the spill file cannot grow while the buffer is spilled
+		 */
+		void spill(std::size_t capacity) {
+			if (spilled_) {
+				spill_file_.grow(capacity - spill_threshold_);
+				return;
+			}
+			// the content above the threshold is lost by mapping the file, so only spill while there is none
+			if (spill_threshold_ == 0 or capacity <= spill_threshold_ or capacity_ > spill_threshold_)
+				return;
+			if (not spill_file_.valid())
+				spill_file_ = util::SpillFile::inTemporaryDirectory();
+			if (not spill_file_.valid())
+				return;
+			try {
+				spill_file_.grow(capacity - spill_threshold_);
+			} catch (const std::runtime_error &) {
+				return;
+			}
+			spilled_ = buffer_.mapFile(spill_threshold_, spill_file_.fd());
+		}
+
+		void unspill() noexcept {
+			buffer_.mapAnonymous(spill_threshold_);
+			spill_file_.shrink(0);
+			spilled_ = false;
+		}
+
+	public:
+		/**
+		 * @param source name of the source used in positions
+		 * @param initial_size the buffer starts with this capacity and shrinks back to it
+		 * @param max_size address space reserved for the buffer, i.e. the maximal size of a single statement
+		 * @param as arguments to construct the Reader
+		 */
+		template<typename T, typename... As>
+		GrowingBufferInput(T &&source, std::size_t initial_size, std::size_t max_size, As &&...as)
+			: reader_(std::forward<As>(as)...),
+			  capacity_(std::max(initial_size, chunk_size)),
+			  initial_capacity_(capacity_),
+			  buffer_(util::BufferPool::instance().acquire(std::max(max_size, capacity_), capacity_)),
+			  current_(buffer_.data()),
+			  end_(buffer_.data()),
+			  source_(std::forward<T>(source)) {
+			spillAbove(Configurations::RdfConcurrentStreamParser_SpillThreshold);
+		}
+
+		GrowingBufferInput(const GrowingBufferInput &) = delete;
+
+		GrowingBufferInput &operator=(const GrowingBufferInput &) = delete;
+
+		~GrowingBufferInput() {
+			// the buffer goes back to the pool and must not refer to the file anymore
+			if (spilled_)
+				unspill();
+		}
+
+		/**
+		 * Sets the capacity above which the buffer is spilled to a temporary file. Must be called before the buffer grows
+		 * beyond it. The threshold is rounded up to a multiple of 2 MiB; 0 keeps the whole buffer in memory.
+		 */
+		void spillAbove(std::size_t threshold) noexcept {
+			spill_threshold_ = (threshold + spill_alignment - 1) / spill_alignment * spill_alignment;
+		}
+
+		[[nodiscard]] bool empty() {
+			require(1);
+			return current_.data == end_;
+		}
+
+		[[nodiscard]] std::size_t size(const std::size_t amount) {
+			require(amount);
+			return buffer_occupied();
+		}
+
+		[[nodiscard]] const char *current() const noexcept { return current_.data; }
+
+		[[nodiscard]] const char *end(const std::size_t amount) {
+			require(amount);
+			return end_;
+		}
+
+		[[nodiscard]] std::size_t byte() const noexcept { return current_.byte; }
+
+		[[nodiscard]] std::size_t line() const noexcept { return current_.line; }
+
+		[[nodiscard]] std::size_t column() const noexcept { return current_.column; }
+
+		[[nodiscard]] char peek_char(const std::size_t offset = 0) const noexcept { return current_.data[offset]; }
+
+		[[nodiscard]] std::uint8_t peek_uint8(const std::size_t offset = 0) const noexcept {
+			return static_cast<std::uint8_t>(peek_char(offset));
+		}
+
+		void bump(const std::size_t in_count = 1) noexcept {
+			tao::pegtl::internal::bump(current_, in_count, Eol::ch);
+		}
+
+		void bump_in_this_line(const std::size_t in_count = 1) noexcept {
+			tao::pegtl::internal::bump_in_this_line(current_, in_count);
+		}
+
+		void bump_to_next_line(const std::size_t in_count = 1) noexcept {
+			tao::pegtl::internal::bump_to_next_line(current_, in_count);
+		}
+
+		/**
+		 * Moves the unparsed rest to the begin of the buffer.
+		 * If a large statement made the buffer grow, the capacity shrinks back and the memory is given back.
+		 */
+		void discard() noexcept {
+			char *const begin = buffer_.data();
+			if (current_.data > begin) {
+				const auto occupied = static_cast<std::size_t>(end_ - current_.data);
+				std::memmove(begin, current_.data, occupied);
+				current_.data = begin;
+				end_ = begin + occupied;
+			}
+			const auto occupied = static_cast<std::size_t>(end_ - begin);
+			const std::size_t old_capacity = capacity_;
+			const std::size_t old_resident = resident(capacity_);
+			while (capacity_ > initial_capacity_ and occupied < capacity_ / 4)
+				capacity_ /= 2;
+			if (spilled_ and capacity_ < old_capacity) {
+				if (capacity_ <= spill_threshold_)
+					unspill();
+				else
+					spill_file_.shrink(capacity_ - spill_threshold_);
+			}
+			if (const std::size_t new_resident = resident(capacity_); new_resident < old_resident)
+				buffer_.uncommit(old_resident - new_resident);
+			if (buffer_.highWater() > capacity_ + initial_capacity_)
+				buffer_.release(std::max(capacity_, occupied));
+		}
+
+		void require(const std::size_t amount) {
+			if (current_.data + amount <= end_)
+				return;
+			char *const begin = buffer_.data();
+			const auto needed = static_cast<std::size_t>(current_.data - begin) + amount;
+			if (needed > buffer_.size())
+				throw std::overflow_error("statement is larger than the maximal buffer size");
+			if (needed > capacity_) {
+				std::size_t new_capacity = capacity_;
+				while (needed > new_capacity)
+					new_capacity = std::min(new_capacity * 2, buffer_.size());
+				const std::size_t old_resident = resident(capacity_);
+				spill(new_capacity);
+				const std::size_t new_resident = resident(new_capacity);
+				// may block until other parsers gave memory back to the pool
+				if (new_resident > old_resident)
+					buffer_.commit(new_resident - old_resident);
+				else
+					buffer_.uncommit(old_resident - new_resident);
+				capacity_ = new_capacity;
+			}
+			const auto free_after_end = static_cast<std::size_t>(begin + capacity_ - end_);
+			std::size_t r;
+			{
+				util::ScopedNanoseconds timer{statistics_ != nullptr ? &statistics_->refill_nanoseconds : nullptr};
+				r = reader_(end_, std::min(free_after_end, std::max(amount - buffer_occupied(), chunk_size)));
+			}
+			if (statistics_ != nullptr)
+				statistics_->refills.fetch_add(1, std::memory_order_relaxed);
+			if (r != 0) {
+				end_ += r;
+				buffer_.touched(static_cast<std::size_t>(end_ - begin));
+			}
+		}
+
+		/**
+		 * Counts the reads of the reader and their time in statistics. The time includes waiting for a slow source.
+		 */
+		void recordStatistics(ParserStatistics &statistics) noexcept {
+			statistics_ = &statistics;
+		}
+
+		template<tao::pegtl::rewind_mode M>
+		[[nodiscard]] auto auto_rewind() noexcept {
+			return tao::pegtl::internal::marker<iterator_t, M>(current_);
+		}
+
+		[[nodiscard]] const iterator_t &iterator() const noexcept { return current_; }
+
+		[[nodiscard]] iterator_t &private_iterator() noexcept { return current_; }
+
+		[[nodiscard]] tao::pegtl::position position(const iterator_t &it) const {
+			return tao::pegtl::position(it, source_);
+		}
+
+		[[nodiscard]] tao::pegtl::position position() const {
+			return position(current_);
+		}
+
+		[[nodiscard]] std::size_t buffer_capacity() const noexcept { return capacity_; }
+
+		// bytes of the capacity that are mapped to the spill file
+		[[nodiscard]] std::size_t buffer_spilled() const noexcept { return capacity_ - resident(capacity_); }
+
+		[[nodiscard]] std::size_t buffer_occupied() const noexcept {
+			return static_cast<std::size_t>(end_ - current_.data);
+		}
+
+		[[nodiscard]] Reader &reader() noexcept { return reader_; }
+	};
+
+	/**
+	 * Reader for GrowingBufferInput reading from a std::istream.
+	 */
+	class IstreamReader {
+		std::istream &stream;
+
+	public:
+		explicit IstreamReader(std::istream &stream) : stream(stream) {}
+
+		std::size_t operator()(char *buffer, std::size_t length) {
+			stream.read(buffer, static_cast<std::streamsize>(length));
+			if (const auto r = stream.gcount())
+				return static_cast<std::size_t>(r);
+			if (stream.eof())
+				return 0;
+			throw std::runtime_error("error reading from the input stream");
+		}
+	};
+
+	template<typename Eol = tao::pegtl::eol::lf_crlf>
+	using IstreamInput = GrowingBufferInput<IstreamReader, Eol>;
+}// namespace Dice::rdf_parser::internal::Turtle::Inputs
+
+#endif//RDF_PARSER_GROWINGBUFFERINPUT_HPP
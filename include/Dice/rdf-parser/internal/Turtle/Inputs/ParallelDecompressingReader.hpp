@@ -0,0 +1,408 @@
+#ifndef RDF_PARSER_PARALLELDECOMPRESSINGREADER_HPP
+#define RDF_PARSER_PARALLELDECOMPRESSINGREADER_HPP
+
+/**
+ * Reader for GrowingBufferInput that decompresses multi-member gzip and multi-frame zstd files with several threads.
+ * The compressed file is mapped into memory and cut into tasks of whole members or frames. Workers decompress the tasks
+ * concurrently and the reader hands the results out in file order, piece by piece while a task is still decompressed.
+ * The decompressed bytes that are held before the parser takes them are bounded by a budget rather than by the number of
+ * tasks, as a small frame can expand to any size.
+ * gzip members can only be found without decompressing them if they carry their size, as BGZF blocks (bgzip) do.
+ * Files that cannot be split are decompressed sequentially, see util::openDecompressingStream.
+ */
+
+#include <algorithm>
+#include <climits>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <zlib.h>
+#include <zstd.h>
+
+#include "Dice/rdf-parser/internal/util/Compression.hpp"
+#include "Dice/rdf-parser/internal/util/FileMapping.hpp"
+
+namespace Dice::rdf_parser::internal::Turtle::Inputs {
+
+	class ParallelDecompressingReader {
+		// decompressed bytes are handed out in pieces of this size
+		static constexpr std::size_t piece_size = 1024 * 1024;
+
+		struct Piece {
+			std::unique_ptr<char[]> data;
+			std::size_t size = 0;
+		};
+
+		struct Task {
+			const char *begin;
+			std::size_t size;
+			// decompressed pieces that were not handed out yet
+			std::deque<Piece> pieces;
+			std::exception_ptr error;
+			bool done = false;
+		};
+
+		Compression compression_;
+		util::FileMapping file_;
+		std::size_t task_size_;
+		std::size_t max_tasks_in_flight_;
+		std::size_t max_bytes_in_flight_;
+
+		std::mutex m;
+		std::condition_variable changed;
+		// tasks in file order, queued, in progress or not completely handed out
+		std::deque<std::shared_ptr<Task>> tasks_;
+		// begin of the part of the file that is not assigned to a task yet
+		std::size_t scan_pos_ = 0;
+		// bytes of the pieces that are allocated and not given back, including the one that is handed out
+		std::size_t bytes_in_flight_ = 0;
+		// pieces that were handed out and can be reused
+		std::vector<std::unique_ptr<char[]>> free_pieces_;
+		bool stopped_ = false;
+
+		Piece current_;
+		std::size_t current_pos_ = 0;
+		std::vector<std::thread> workers_;
+
+		/**
+		 * Destination of the decompressed bytes of a task. A piece is handed out as soon as it is full, so the parser can
+		 * start on a task before it is decompressed completely, and a task needs no more memory than the budget allows.
+		 */
+		class TaskOutput {
+			ParallelDecompressingReader &reader_;
+			Task &task_;
+			std::unique_ptr<char[]> piece_;
+			std::size_t filled_ = 0;
+
+		public:
+			TaskOutput(ParallelDecompressingReader &reader, Task &task) : reader_{reader}, task_{task} {}
+
+			TaskOutput(const TaskOutput &) = delete;
+
+			TaskOutput &operator=(const TaskOutput &) = delete;
+
+			~TaskOutput() {
+				if (piece_)
+					reader_.release(std::move(piece_));
+			}
+
+			/**
+			 * @return free space for the next decompressed bytes. Waits if the bytes in flight are at the budget.
+			 */
+			std::pair<char *, std::size_t> space() {
+				if (piece_ and filled_ == piece_size)
+					flush();
+				if (not piece_)
+					piece_ = reader_.allocate(task_);
+				return {piece_.get() + filled_, piece_size - filled_};
+			}
+
+			void wrote(std::size_t n) noexcept {
+				filled_ += n;
+			}
+
+			void flush() {
+				if (filled_ == 0)
+					return;
+				reader_.publish(task_, {std::move(piece_), filled_});
+				filled_ = 0;
+			}
+		};
+
+		/**
+		 * @return size of the BGZF block at data, or 0 if it is not a BGZF block
+		 */
+		static std::size_t bgzfBlockSize(const unsigned char *data, std::size_t available) noexcept {
+			if (available < 18 or data[0] != 0x1f or data[1] != 0x8b or data[2] != 8 or (data[3] & 4) == 0)
+				return 0;
+			const std::size_t extra_end = 12 + (data[10] | (data[11] << 8));
+			if (extra_end > available)
+				return 0;
+			for (std::size_t pos = 12; pos + 4 <= extra_end;) {
+				const std::size_t length = data[pos + 2] | (data[pos + 3] << 8);
+				if (data[pos] == 'B' and data[pos + 1] == 'C' and length == 2 and pos + 6 <= extra_end) {
+					const std::size_t block_size = (data[pos + 4] | (data[pos + 5] << 8)) + 1;
+					return block_size <= available ? block_size : 0;
+				}
+				pos += 4 + length;
+			}
+			return 0;
+		}
+
+		/**
+		 * @return compressed size of the member or frame at data, or 0 if it cannot be determined without decompressing
+		 */
+		static std::size_t frameSize(Compression compression, const char *data, std::size_t available) noexcept {
+			if (compression == Compression::Gzip)
+				return bgzfBlockSize(reinterpret_cast<const unsigned char *>(data), available);
+			if (compression == Compression::Zstd) {
+				const std::size_t size = ZSTD_findFrameCompressedSize(data, available);
+				return ZSTD_isError(size) ? 0 : size;
+			}
+			return 0;
+		}
+
+		static void inflateMembers(const char *data, std::size_t size, TaskOutput &output) {
+			z_stream stream{};
+			// 16 + MAX_WBITS: expect a gzip header
+			if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK)
+				throw std::runtime_error{"cannot initialize zlib"};
+			std::unique_ptr<z_stream, decltype(&inflateEnd)> guard{&stream, &inflateEnd};
+			stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+			std::size_t remaining = size;
+			for (;;) {
+				if (stream.avail_in == 0 and remaining != 0) {
+					stream.avail_in = static_cast<uInt>(std::min<std::size_t>(remaining, UINT_MAX));
+					remaining -= stream.avail_in;
+				}
+				const auto [buffer, length] = output.space();
+				const auto available = static_cast<uInt>(std::min<std::size_t>(length, UINT_MAX));
+				stream.next_out = reinterpret_cast<Bytef *>(buffer);
+				stream.avail_out = available;
+				const int result = inflate(&stream, Z_NO_FLUSH);
+				output.wrote(available - stream.avail_out);
+				if (result == Z_STREAM_END) {
+					if (stream.avail_in == 0 and remaining == 0)
+						break;
+					inflateReset(&stream);
+				} else if (result != Z_OK and not(result == Z_BUF_ERROR and stream.avail_out == 0)) {
+					throw std::runtime_error{stream.msg != nullptr ? stream.msg : "corrupt or truncated gzip member"};
+				}
+			}
+			output.flush();
+		}
+
+		static void decompressFrames(const char *data, std::size_t size, TaskOutput &output) {
+			std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+			if (not context)
+				throw std::runtime_error{"cannot initialize zstd"};
+			ZSTD_inBuffer input{data, size, 0};
+			for (;;) {
+				const auto [buffer, length] = output.space();
+				ZSTD_outBuffer out{buffer, length, 0};
+				const std::size_t result = ZSTD_decompressStream(context.get(), &out, &input);
+				if (ZSTD_isError(result))
+					throw std::runtime_error{ZSTD_getErrorName(result)};
+				output.wrote(out.pos);
+				// 0 means the last frame is complete and flushed
+				if (input.pos == input.size and result == 0)
+					break;
+				if (input.pos == input.size and out.pos < out.size)
+					throw std::runtime_error{"truncated zstd frame"};
+			}
+			output.flush();
+		}
+
+		/**
+		 * Waits until the budget has room for another piece. The task the parser waits for always gets a piece while it has
+		 * none to hand out, so the parser makes progress even if other tasks hold the whole budget.
+		 * @throws std::runtime_error if the reader is destroyed meanwhile
+		 */
+		std::unique_ptr<char[]> allocate(const Task &task) {
+			std::unique_lock<std::mutex> lk(m);
+			changed.wait(lk, [&] {
+				return stopped_ or bytes_in_flight_ + piece_size <= max_bytes_in_flight_ or
+					   (tasks_.front().get() == &task and task.pieces.empty());
+			});
+			if (stopped_)
+				throw std::runtime_error{"the reader was destroyed"};
+			bytes_in_flight_ += piece_size;
+			if (not free_pieces_.empty()) {
+				auto piece = std::move(free_pieces_.back());
+				free_pieces_.pop_back();
+				return piece;
+			}
+			lk.unlock();
+			return std::make_unique_for_overwrite<char[]>(piece_size);
+		}
+
+		void publish(Task &task, Piece piece) {
+			{
+				std::lock_guard<std::mutex> lk(m);
+				task.pieces.push_back(std::move(piece));
+			}
+			changed.notify_all();
+		}
+
+		// requires m to be locked
+		void releaseLocked(std::unique_ptr<char[]> piece) {
+			bytes_in_flight_ -= piece_size;
+			if (free_pieces_.size() < max_tasks_in_flight_)
+				free_pieces_.push_back(std::move(piece));
+		}
+
+		void release(std::unique_ptr<char[]> piece) {
+			{
+				std::lock_guard<std::mutex> lk(m);
+				releaseLocked(std::move(piece));
+			}
+			changed.notify_all();
+		}
+
+		// requires m to be locked
+		std::shared_ptr<Task> nextTask() {
+			auto task = std::make_shared<Task>();
+			task->begin = file_.data() + scan_pos_;
+			std::size_t end = scan_pos_;
+			while (end < file_.size() and end - scan_pos_ < task_size_) {
+				const std::size_t size = frameSize(compression_, file_.data() + end, file_.size() - end);
+				// the rest cannot be split; it becomes one task and is checked when it is decompressed
+				end = size == 0 ? file_.size() : end + size;
+			}
+			task->size = end - scan_pos_;
+			scan_pos_ = end;
+			return task;
+		}
+
+		void work() {
+			for (;;) {
+				std::shared_ptr<Task> task;
+				{
+					std::unique_lock<std::mutex> lk(m);
+					changed.wait(lk, [&] { return stopped_ or scan_pos_ == file_.size() or tasks_.size() < max_tasks_in_flight_; });
+					if (stopped_ or scan_pos_ == file_.size())
+						return;
+					task = nextTask();
+					tasks_.push_back(task);
+				}
+				std::exception_ptr error;
+				try {
+					TaskOutput output{*this, *task};
+					if (compression_ == Compression::Gzip)
+						inflateMembers(task->begin, task->size, output);
+					else
+						decompressFrames(task->begin, task->size, output);
+				} catch (...) {
+					error = std::current_exception();
+				}
+				{
+					std::lock_guard<std::mutex> lk(m);
+					task->error = error;
+					task->done = true;
+				}
+				changed.notify_all();
+			}
+		}
+
+		/**
+		 * Gives the handed out piece back and takes the next one in file order.
+		 * @return false at the end of the file
+		 */
+		bool nextPiece() {
+			std::unique_lock<std::mutex> lk(m);
+			if (current_.data)
+				releaseLocked(std::move(current_.data));
+			current_ = {};
+			for (;;) {
+				// workers wait for the budget and for their task to get to the front
+				changed.notify_all();
+				changed.wait(lk, [&] {
+					return (not tasks_.empty() and (not tasks_.front()->pieces.empty() or tasks_.front()->done)) or
+						   (tasks_.empty() and scan_pos_ == file_.size());
+				});
+				if (tasks_.empty())
+					return false;
+				auto &task = *tasks_.front();
+				if (not task.pieces.empty()) {
+					current_ = std::move(task.pieces.front());
+					task.pieces.pop_front();
+					current_pos_ = 0;
+					break;
+				}
+				// the task is done and completely handed out
+				const auto error = task.error;
+				tasks_.pop_front();
+				if (error) {
+					lk.unlock();
+					changed.notify_all();
+					std::rethrow_exception(error);
+				}
+			}
+			lk.unlock();
+			changed.notify_all();
+			return true;
+		}
+
+	public:
+		/**
+		 * @return if the file consists of several gzip members with known sizes (BGZF) or several zstd frames
+		 */
+		static bool splittable(const std::filesystem::path &path, Compression compression) {
+			if (compression != Compression::Gzip and compression != Compression::Zstd)
+				return false;
+			util::FileMapping file{path};
+			const std::size_t first = frameSize(compression, file.data(), file.size());
+			return first != 0 and first < file.size();
+		}
+
+		/**
+		 * @param path the compressed file
+		 * @param compression Gzip or Zstd
+		 * @param threads number of decompressing threads; 0 uses one per hardware thread
+		 * @param task_size compressed bytes decompressed by one thread at once
+		 * @param max_bytes_in_flight decompressed bytes that are held at most before the parser takes them. Threads wait
+		 * while they are used up. At least one piece of 1 MiB is allowed.
+		 */
+		ParallelDecompressingReader(const std::filesystem::path &path, Compression compression,
+									std::size_t threads = 0, std::size_t task_size = 4 * 1024 * 1024,
+									std::size_t max_bytes_in_flight = 256 * 1024 * 1024)
+			: compression_{compression},
+			  file_{path},
+			  task_size_{std::max<std::size_t>(task_size, 1)},
+			  max_bytes_in_flight_{std::max(max_bytes_in_flight, piece_size)} {
+			if (compression != Compression::Gzip and compression != Compression::Zstd)
+				throw std::invalid_argument{"only gzip and zstd files can be decompressed in parallel"};
+			if (threads == 0)
+				threads = std::max(std::thread::hardware_concurrency(), 1u);
+			// each thread can work on one task while another one waits for the parser
+			max_tasks_in_flight_ = 2 * threads;
+			file_.advise(MADV_SEQUENTIAL);
+			workers_.reserve(threads);
+			for (std::size_t i = 0; i < threads; ++i)
+				workers_.emplace_back(&ParallelDecompressingReader::work, this);
+		}
+
+		ParallelDecompressingReader(const ParallelDecompressingReader &) = delete;
+
+		ParallelDecompressingReader &operator=(const ParallelDecompressingReader &) = delete;
+
+		~ParallelDecompressingReader() {
+			{
+				std::lock_guard<std::mutex> lk(m);
+				stopped_ = true;
+			}
+			changed.notify_all();
+			for (auto &worker : workers_)
+				worker.join();
+		}
+
+		std::size_t operator()(char *buffer, std::size_t length) {
+			std::size_t copied = 0;
+			while (copied < length) {
+				if (current_pos_ == current_.size) {
+					// hand over what we have instead of waiting for the next piece
+					if (copied != 0 or not nextPiece())
+						break;
+					continue;
+				}
+				const std::size_t n = std::min(length - copied, current_.size - current_pos_);
+				std::memcpy(buffer + copied, current_.data.get() + current_pos_, n);
+				current_pos_ += n;
+				copied += n;
+			}
+			return copied;
+		}
+	};
+}// namespace Dice::rdf_parser::internal::Turtle::Inputs
+
+#endif//RDF_PARSER_PARALLELDECOMPRESSINGREADER_HPP
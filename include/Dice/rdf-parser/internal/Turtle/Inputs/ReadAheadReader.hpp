@@ -0,0 +1,219 @@
+#ifndef RDF_PARSER_READAHEADREADER_HPP
+#define RDF_PARSER_READAHEADREADER_HPP
+
+/**
+ * Reader for GrowingBufferInput that runs the actual reading in its own thread.
+ * The thread reads up to blocks_in_flight blocks ahead of the parser, so reading (or decompressing) and parsing overlap.
+ * Every read is handed over as soon as it returns, even if it did not fill the block: a pipe or stdin returns what has
+ * arrived, and the parser must see it without waiting for a whole block.
+ *
+ * Blocks are reused without being cleared. When the parser finds no filled block, it does not wait for one: the thread reads
+ * its next piece directly into the buffer of the parser, so the bytes are only copied out of a block when the thread is ahead.
+ *
+ * The destructor waits for the thread, so it waits for a read that is blocked in the producer. Producers that read
+ * pipes or stdin must be able to return 0 when the parser is cancelled (see FileDescriptorReader::interruptOn).
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Dice::rdf_parser::internal::Turtle::Inputs {
+
+	class ReadAheadReader {
+	public:
+		/**
+		 * Reads at most length bytes into buffer and returns how many were read. Returns 0 at the end.
+		 */
+		using Producer = std::function<std::size_t(char *buffer, std::size_t length)>;
+
+	private:
+		struct Block {
+			std::unique_ptr<char[]> data;
+			std::size_t size = 0;
+		};
+
+		struct Shared {
+			std::mutex m;
+			std::condition_variable block_filled;
+			std::condition_variable block_taken;
+			std::deque<Block> filled;
+			// blocks that were handed out and can be reused by the producer; their content is overwritten, never cleared
+			std::vector<std::unique_ptr<char[]>> free;
+			// buffer of the parser, which waits for the producer to read into it directly
+			char *direct = nullptr;
+			std::size_t direct_length = 0;
+			// set when the producer starts reading into direct; the read is complete when direct is reset
+			bool direct_taken = false;
+			std::size_t direct_read = 0;
+			std::exception_ptr error;
+			bool done = false;
+			bool stopped = false;
+		};
+
+		std::shared_ptr<Shared> shared_;
+		Block current_;
+		std::size_t current_pos_ = 0;
+		bool at_end_ = false;
+		std::thread thread_;
+
+		static void produce(Shared &shared, Producer producer, std::size_t block_size, std::size_t blocks_in_flight) {
+			try {
+				for (;;) {
+					char *target = nullptr;
+					std::size_t length = block_size;
+					bool direct = false;
+					std::unique_ptr<char[]> block;
+					{
+						std::unique_lock<std::mutex> lk(shared.m);
+						// a direct read must not overtake a filled block, which the parser takes instead
+						const auto directRequested = [&] { return shared.direct != nullptr and shared.filled.empty(); };
+						shared.block_taken.wait(lk, [&] {
+							return shared.stopped or directRequested() or shared.filled.size() < blocks_in_flight;
+						});
+						if (shared.stopped)
+							return;
+						if (directRequested()) {
+							direct = shared.direct_taken = true;
+							target = shared.direct;
+							length = shared.direct_length;
+						} else if (not shared.free.empty()) {
+							block = std::move(shared.free.back());
+							shared.free.pop_back();
+						}
+					}
+					if (not direct) {
+						if (not block)
+							block = std::make_unique_for_overwrite<char[]>(block_size);
+						target = block.get();
+					}
+					const std::size_t filled = producer(target, length);
+					const bool end = filled == 0;
+					{
+						std::lock_guard<std::mutex> lk(shared.m);
+						if (direct) {
+							shared.direct = nullptr;
+							shared.direct_taken = false;
+							shared.direct_read = filled;
+						} else if (not end) {
+							shared.filled.push_back({std::move(block), filled});
+						}
+						shared.done = end;
+					}
+					shared.block_filled.notify_one();
+					if (end)
+						return;
+				}
+			} catch (...) {
+				{
+					std::lock_guard<std::mutex> lk(shared.m);
+					shared.direct = nullptr;
+					shared.direct_taken = false;
+					shared.direct_read = 0;
+					shared.error = std::current_exception();
+					shared.done = true;
+				}
+				shared.block_filled.notify_one();
+			}
+		}
+
+		/**
+		 * Gives the current block back and takes the next one. If none is filled yet, the producer reads directly into
+		 * buffer instead, so the bytes are not copied once more while the parser waits anyway.
+		 * @return bytes read into buffer directly; 0 if a block was taken or at the end
+		 */
+		std::size_t nextBlock(char *buffer, std::size_t length) {
+			std::unique_lock<std::mutex> lk(shared_->m);
+			if (current_.data) {
+				shared_->free.push_back(std::move(current_.data));
+				current_ = {};
+				current_pos_ = 0;
+			}
+			if (shared_->filled.empty() and not shared_->done) {
+				shared_->direct = buffer;
+				shared_->direct_length = length;
+				shared_->block_taken.notify_one();
+				// a block that the producer completed meanwhile comes first; the request is withdrawn unless it is taken
+				shared_->block_filled.wait(lk, [&] {
+					return shared_->direct == nullptr or
+						   (not shared_->direct_taken and (not shared_->filled.empty() or shared_->done));
+				});
+				if (shared_->direct == nullptr) {
+					if (shared_->error)
+						std::rethrow_exception(shared_->error);
+					// 0 is the end of the source, which is handled below
+					if (shared_->direct_read != 0)
+						return shared_->direct_read;
+				} else {
+					shared_->direct = nullptr;
+				}
+			}
+			shared_->block_filled.wait(lk, [&] { return not shared_->filled.empty() or shared_->done; });
+			if (shared_->filled.empty()) {
+				if (shared_->error)
+					std::rethrow_exception(shared_->error);
+				at_end_ = true;
+				return 0;
+			}
+			current_ = std::move(shared_->filled.front());
+			shared_->filled.pop_front();
+			current_pos_ = 0;
+			lk.unlock();
+			shared_->block_taken.notify_one();
+			return 0;
+		}
+
+	public:
+		/**
+		 * @param producer reads the underlying source. It is called from the read-ahead thread only.
+		 * @param block_size the most bytes read at once
+		 * @param blocks_in_flight number of blocks read ahead of the parser
+		 */
+		explicit ReadAheadReader(Producer producer, std::size_t block_size = 4 * 1024 * 1024, std::size_t blocks_in_flight = 4)
+			: shared_{std::make_shared<Shared>()},
+			  thread_{&ReadAheadReader::produce, std::ref(*shared_), std::move(producer), std::max<std::size_t>(block_size, 1),
+					  std::max<std::size_t>(blocks_in_flight, 1)} {}
+
+		ReadAheadReader(const ReadAheadReader &) = delete;
+
+		ReadAheadReader &operator=(const ReadAheadReader &) = delete;
+
+		~ReadAheadReader() {
+			{
+				std::lock_guard<std::mutex> lk(shared_->m);
+				shared_->stopped = true;
+			}
+			shared_->block_taken.notify_all();
+			thread_.join();
+		}
+
+		std::size_t operator()(char *buffer, std::size_t length) {
+			std::size_t copied = 0;
+			while (copied < length and not at_end_) {
+				if (current_pos_ == current_.size) {
+					// hand over what we have instead of waiting for the next block
+					if (copied != 0)
+						break;
+					if (const std::size_t read = nextBlock(buffer, length); read != 0)
+						return read;
+					continue;
+				}
+				const std::size_t n = std::min(length - copied, current_.size - current_pos_);
+				std::memcpy(buffer + copied, current_.data.get() + current_pos_, n);
+				current_pos_ += n;
+				copied += n;
+			}
+			return copied;
+		}
+	};
+}// namespace Dice::rdf_parser::internal::Turtle::Inputs
+
+#endif//RDF_PARSER_READAHEADREADER_HPP
@@ -1,12 +1,22 @@
 #ifndef RDF_PARSER_ABSTRACTPARSER_HPP
 #define RDF_PARSER_ABSTRACTPARSER_HPP
 
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+
 #include "Dice/RDF/Triple.hpp"
 #include "Dice/SPARQL/TriplePattern.hpp"
+#include "Dice/rdf-parser/ParserStatistics.hpp"
 
 
 /**
  * Base class for parsing triples from different sources.
+ * Parsers are single-pass input ranges (std::ranges::input_range) whose end is std::default_sentinel, so they compose with
+ * std::views. Dereferencing an iterator gives the current triple of the parser, which may be moved from.
  */
 
 namespace Dice::rdf_parser::internal::Turtle::Parsers {
@@ -29,6 +39,11 @@ namespace Dice::rdf_parser::internal::Turtle::Parsers {
 
 		element_type current_triple;
 
+		// counters of the parse; the parser records them in its states and inputs
+		ParserStatistics statistics_;
+
+	private:
+		std::unique_ptr<ProgressReporter> progress_reporter_;
 
 	public:
 		/**
@@ -41,7 +56,7 @@ namespace Dice::rdf_parser::internal::Turtle::Parsers {
 		/**
          * check whether there is a further triple
          */
-		[[nodiscard]] virtual bool hasNextTriple() {
+		[[nodiscard]] bool hasNextTriple() {
 			return static_cast<Derived *>(this)->hasNextTriple_impl();
 		}
 
@@ -52,6 +67,46 @@ namespace Dice::rdf_parser::internal::Turtle::Parsers {
 			return current_triple;
 		}
 
+		/**
+         * get the current triple to take ownership of it, e.g. with std::move. It is left in a valid but unspecified state.
+         */
+		element_type &currentTriple() noexcept {
+			return current_triple;
+		}
+
+		/**
+         * move the current triple out of the parser
+         */
+		element_type takeCurrentTriple() {
+			return std::move(current_triple);
+		}
+
+
+		/**
+         * get the statistics of the parse. They are updated while the parser runs and may be read from any thread.
+         */
+		[[nodiscard]] const ParserStatistics &statistics() const noexcept {
+			if constexpr (requires(const Derived &derived) { derived.statistics_impl(); })
+				return static_cast<const Derived *>(this)->statistics_impl();
+			else
+				return statistics_;
+		}
+
+		/**
+         * call callback with a snapshot of the statistics every interval, from a thread of its own, and a last time when the
+         * parse is done. A previous callback is replaced. Reporting stops when the parser is destroyed.
+         */
+		void reportProgress(std::chrono::milliseconds interval, std::function<void(const ParserProgress &)> callback) {
+			progress_reporter_.reset();
+			progress_reporter_ = std::make_unique<ProgressReporter>(statistics(), interval, std::move(callback));
+		}
+
+		/**
+         * stop calling the progress callback
+         */
+		void stopReportingProgress() noexcept {
+			progress_reporter_.reset();
+		}
 
 		virtual ~AbstractParser() = default;
 
@@ -60,7 +115,7 @@ namespace Dice::rdf_parser::internal::Turtle::Parsers {
 			return static_cast<Derived *>(this)->begin_impl();
 		}
 
-		bool end() { return false; }
+		std::default_sentinel_t end() const noexcept { return {}; }
 	};
 
 	template<class Parser, bool sparqlQuery>
@@ -71,34 +126,60 @@ namespace Dice::rdf_parser::internal::Turtle::Parsers {
 		using Triple_t = std::conditional_t<sparqlQuery, TriplePattern, Triple>;
 
 	private:
-		bool done_;
-		bool parser_done_;
+		// the next triple is only taken from the parser when the iterator is compared or dereferenced, so a parser that
+		// waits for more input, e.g. a followed file, hands out a triple without waiting for the one after it
+		mutable bool done_ = true;
+		mutable bool pending_ = false;
 		Parser *triplesParser = nullptr;
 
-	public:
-		explicit Iterator(Parser *triplesParser) : done_{false}, parser_done_{false}, triplesParser{triplesParser} {
-			//check if there is at least one parsed triple
+		void fetch() const {
+			if (not pending_)
+				return;
+			pending_ = false;
 			if (triplesParser->hasNextTriple())
-				this->operator++();
+				triplesParser->nextTriple();
 			else
-				parser_done_ = true;
-		};
-
-		void operator++() {
-			if (parser_done_) {
 				done_ = true;
-			} else {
-				triplesParser->nextTriple();
-				if (not triplesParser->hasNextTriple())
-					parser_done_ = true;
-			}
+		}
+
+	public:
+		using value_type = Triple_t;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::input_iterator_tag;
+		using iterator_concept = std::input_iterator_tag;
+
+		Iterator() = default;
+
+		explicit Iterator(Parser *triplesParser) : done_{false}, pending_{true}, triplesParser{triplesParser} {}
+
+		Iterator &operator++() {
+			fetch();
+			if (not done_)
+				pending_ = true;
+			return *this;
 		}
 
 		void operator++(int) { operator++(); }
 
-		operator bool() { return not done_; }
+		operator bool() const {
+			fetch();
+			return not done_;
+		}
+
+		Triple_t &operator*() const {
+			fetch();
+			return triplesParser->currentTriple();
+		}
 
-		const Triple_t &operator*() { return triplesParser->getCurrentTriple(); }
+		Triple_t *operator->() const {
+			fetch();
+			return &triplesParser->currentTriple();
+		}
+
+		friend bool operator==(const Iterator &iterator, std::default_sentinel_t) {
+			iterator.fetch();
+			return iterator.done_;
+		}
 	};
 
 
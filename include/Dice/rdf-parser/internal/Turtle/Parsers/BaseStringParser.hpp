@@ -3,17 +3,25 @@
 
 
 #include <chrono>
+#include <cstdint>
+#include <optional>
 
 #include <robin_hood.h>
 
+#include "Dice/rdf-parser/InputSource.hpp"
 #include "Dice/rdf-parser/exception/RDFParsingExecption.hpp"
 #include "Dice/rdf-parser/internal/Turtle/Actions/Actions.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Control.hpp"
 #include "Dice/rdf-parser/internal/Turtle/Parsers/AbstractParser.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Parsers/StatementGenerator.hpp"
 #include "Dice/rdf-parser/internal/Turtle/States/SequentialState.hpp"
+#include "Dice/rdf-parser/internal/util/Generator.hpp"
+#include "Dice/rdf-parser/internal/util/ParseErrors.hpp"
 
 /**
  * BaseStringParser is a base class for parsing string sources .
- * It parse the string one time and put the parsed elements in a std::queue
+ * It parse the string one time and put the parsed elements in a std::queue.
+ * In lazy mode the string is instead parsed statement by statement while it is iterated.
  */
 
 namespace Dice::rdf_parser::internal::Turtle::Parsers {
@@ -31,6 +39,11 @@ namespace Dice::rdf_parser::internal::Turtle::Parsers {
          */
 		std::queue<Triple_t> parsedTerms;
 
+		/**
+		 * set in lazy mode; parsedTerms stays empty then.
+		 */
+		std::optional<util::GeneratorCursor<Triple_t>> lazyTerms;
+
 	protected:
 		/**
          * The constructor start the parsing.if the input is not valid it will throws and exception.
@@ -38,16 +51,14 @@ namespace Dice::rdf_parser::internal::Turtle::Parsers {
          * @param text the string to parse
          */
 		explicit BaseStringParser(std::string text) {
-			try {
-				tao::pegtl::string_input input(std::move(text), "the text");
-				States::SequentialState<sparqlQuery> state(parsedTerms);
-				tao::pegtl::parse<Grammar::grammar<sparqlQuery>, Actions::action>(input, state);
-
-			} catch (std::exception &e) {
-				throw exception::RDFParsingException();
-			}
+			parse(std::move(text), {});
 		}
 
+		/**
+		 * Used by subclasses that parse other in-memory inputs with parseInput.
+		 */
+		BaseStringParser() = default;
+
 		/**
         * The constructor start the parsing.if the input is not valid it will throws and exception.
         * it also invoke nextTriple to have the first triple ready for using .
@@ -55,27 +66,97 @@ namespace Dice::rdf_parser::internal::Turtle::Parsers {
         * @param prefix_map defines prefixes to be added before parsing
         */
 		BaseStringParser(std::string text, const robin_hood::unordered_map<std::string, std::string> &prefix_map) {
+			parse(std::move(text), prefix_map);
+		}
+
+		/**
+		 * Parses a whole in-memory input (e.g. tao::pegtl::memory_input or tao::pegtl::mmap_input) into parsedTerms.
+		 * Positions should be tracked lazily; they are only computed from the byte offset if the parsing fails.
+		 * @throws exception::RDFParsingException with the position of the error
+		 */
+		template<typename Input>
+		void parseInput(Input &input, const robin_hood::unordered_map<std::string, std::string> &prefix_map) {
+			auto &statistics = this->statistics_;
+			const auto size = static_cast<std::uint64_t>(input.end() - input.begin());
+			statistics.bytes_total.store(size, std::memory_order_relaxed);
 			try {
-				tao::pegtl::string_input input(text, "the text");
 				States::SequentialState<sparqlQuery> state(parsedTerms);
-				for (auto pair : prefix_map)
+				state.recordStatistics(statistics);
+				for (const auto &pair : prefix_map)
 					state.addPrefix(pair.first, pair.second);
-				tao::pegtl::parse<Grammar::grammar<sparqlQuery>, Actions::action>(input, state);
+				tao::pegtl::parse<Grammar::grammar<sparqlQuery>, Actions::action, Turtle::control>(input, state);
+				// whitespace and comments after the last statement are consumed as well
+				statistics.bytes_consumed.store(size, std::memory_order_relaxed);
+				statistics.finish();
+			} catch (const tao::pegtl::parse_error &e) {
+				statistics.finish();
+				throw util::fromParseError(e, std::string_view(input.begin(), input.end() - input.begin()));
+			} catch (const std::exception &e) {
+				statistics.finish();
+				throw ::Dice::rdf_parser::exception::RDFParsingException(e.what());
+			}
+		}
 
-			} catch (std::exception &e) {
-				throw exception::RDFParsingException();
+		/**
+		 * Parses the whole content of a source. Contiguous sources are parsed in place, others are read into a string first.
+		 */
+		template<InputSource Source>
+		void parseSource(Source &source, const robin_hood::unordered_map<std::string, std::string> &prefix_map) {
+			if constexpr (ContiguousInputSource<Source>) {
+				const std::string_view data = source.contiguous();
+				tao::pegtl::memory_input<tao::pegtl::tracking_mode::lazy> input(data.data(), data.size(), source.name());
+				parseInput(input, prefix_map);
+			} else {
+				std::string text;
+				try {
+					text = util::readAll(source);
+				} catch (const std::exception &e) {
+					throw ::Dice::rdf_parser::exception::RDFParsingException(e.what());
+				}
+				tao::pegtl::string_input<tao::pegtl::tracking_mode::lazy> input(std::move(text), source.name());
+				parseInput(input, prefix_map);
 			}
 		}
 
+		/**
+		 * Parses the text while it is iterated. Errors are thrown when the iteration reaches them.
+		 */
+		void parseLazily(std::string text, robin_hood::unordered_map<std::string, std::string> prefix_map) {
+			static_assert(not sparqlQuery, "lazy parsing is only supported for Turtle documents");
+			lazyTerms.emplace(generateTriples(std::make_unique<tao::pegtl::string_input<tao::pegtl::tracking_mode::lazy>>(std::move(text), "the text"),
+											  States::StatementContext{std::move(prefix_map)}, &this->statistics_));
+		}
+
+		/**
+		 * Parses a source while it is iterated. Only contiguous sources are held in memory as a whole.
+		 */
+		template<InputSource Source>
+		void parseSourceLazily(Source source, robin_hood::unordered_map<std::string, std::string> prefix_map) {
+			static_assert(not sparqlQuery, "lazy parsing is only supported for Turtle documents");
+			lazyTerms.emplace(generateTriplesFromSource(std::move(source), States::StatementContext{std::move(prefix_map)}, &this->statistics_));
+		}
+
+	private:
+		void parse(std::string text, const robin_hood::unordered_map<std::string, std::string> &prefix_map) {
+			tao::pegtl::string_input<tao::pegtl::tracking_mode::lazy> input(std::move(text), "the text");
+			parseInput(input, prefix_map);
+		}
+
 	public:
-		[[nodiscard]] bool hasNextTriple_impl() const {
+		[[nodiscard]] bool hasNextTriple_impl() {
+			if (lazyTerms)
+				return lazyTerms->hasNext();
 			return not parsedTerms.empty();
 		}
 
 		~BaseStringParser() override = default;
 
 		void nextTriple_impl() {
-			this->current_triple = parsedTerms.front();
+			if (lazyTerms) {
+				this->current_triple = std::move(lazyTerms->next());
+				return;
+			}
+			this->current_triple = std::move(parsedTerms.front());
 			parsedTerms.pop();
 		}
 
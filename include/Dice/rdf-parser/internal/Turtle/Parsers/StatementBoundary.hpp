@@ -0,0 +1,139 @@
+#ifndef RDF_PARSER_STATEMENTBOUNDARY_HPP
+#define RDF_PARSER_STATEMENTBOUNDARY_HPP
+
+/**
+ * Finding statement boundaries in the middle of an in-memory document, so that a parse can start there.
+ *
+ * A boundary is the begin of a line whose previous non-whitespace character is the '.' ending a statement, and from which
+ * the next statements parse. Every line of an N-Triples document is a boundary. In Turtle, a line within a multi-line
+ * literal could look like a boundary; checking that the following statements parse makes that unlikely.
+ * Lines ending in a comment are skipped as candidates; the next line is taken instead.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include <tao/pegtl.hpp>
+
+#include "Dice/rdf-parser/internal/Turtle/Actions/Actions.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Control.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Grammar.hpp"
+#include "Dice/rdf-parser/internal/Turtle/States/StatementContext.hpp"
+#include "Dice/rdf-parser/internal/Turtle/States/VectorState.hpp"
+
+namespace Dice::rdf_parser::internal::Turtle::Parsers {
+
+	namespace boundary {
+		using Input = tao::pegtl::memory_input<tao::pegtl::tracking_mode::lazy, tao::pegtl::eol::lf_crlf, const char *>;
+
+		// statements that must parse after a candidate boundary
+		inline constexpr std::size_t verified_statements = 2;
+
+		inline bool isWhitespace(char c) noexcept {
+			return c == ' ' or c == '\t' or c == '\r' or c == '\n';
+		}
+
+		inline bool followsStatement(std::string_view document, std::size_t line_begin) noexcept {
+			std::size_t i = line_begin;
+			while (i > 0 and isWhitespace(document[i - 1]))
+				--i;
+			return i > 0 and document[i - 1] == '.';
+		}
+
+		inline bool statementsParse(std::string_view document, std::size_t begin) {
+			Input in(document.data() + begin, document.data() + document.size(), "boundary");
+			try {
+				for (std::size_t i = 0; i < verified_statements; ++i) {
+					tao::pegtl::parse<Grammar::ignored>(in);
+					if (in.empty())
+						return true;
+					if (not tao::pegtl::parse<Grammar::statement, tao::pegtl::nothing, control>(in))
+						return false;
+				}
+				return true;
+			} catch (const tao::pegtl::parse_error &) {
+				return false;
+			}
+		}
+
+		inline bool startsWithDirective(std::string_view line) noexcept {
+			auto startsWith = [&](std::string_view keyword) {
+				if (line.size() <= keyword.size())
+					return false;
+				for (std::size_t i = 0; i < keyword.size(); ++i) {
+					// SPARQL style directives are case-insensitive
+					const char c = line[i] >= 'A' and line[i] <= 'Z' ? static_cast<char>(line[i] - 'A' + 'a') : line[i];
+					if (c != keyword[i])
+						return false;
+				}
+				return isWhitespace(line[keyword.size()]);
+			};
+			return startsWith("@prefix") or startsWith("@base") or startsWith("prefix") or startsWith("base");
+		}
+	}// namespace boundary
+
+	/**
+	 * @param document the whole document
+	 * @param offset any byte offset in the document
+	 * @param limit candidates at or after limit are not checked. If there is no boundary before it, the begin of the first
+	 * line at or after offset is returned instead, so that a search on invalid data does not run to the end of the document.
+	 * @return the first statement boundary at or after offset; document.size() if there is none
+	 */
+	inline std::size_t nextStatementBoundary(std::string_view document, std::size_t offset, std::size_t limit = std::string_view::npos) {
+		if (offset == 0)
+			return 0;
+		limit = std::min(limit, document.size());
+		std::size_t first_line = document.size();
+		for (std::size_t line = offset; line < document.size();) {
+			if (document[line - 1] != '\n') {
+				const auto newline = document.find('\n', line);
+				if (newline == std::string_view::npos)
+					break;
+				line = newline + 1;
+				continue;
+			}
+			first_line = std::min(first_line, line);
+			if (line >= limit)
+				return first_line;
+			if (boundary::followsStatement(document, line) and boundary::statementsParse(document, line))
+				return line;
+			++line;
+		}
+		return document.size();
+	}
+
+	/**
+	 * Applies the directives (@prefix, @base, PREFIX, BASE) that start a line in [begin, end) to context, in document order.
+	 * Only the directives are parsed, so this is much faster than parsing the range. Directives that do not start a line
+	 * are not found.
+	 */
+	inline void collectDirectives(std::string_view document, std::size_t begin, std::size_t end, States::StatementContext &context) {
+		States::VectorState<false> state;
+		context.applyTo(state);
+		std::vector<Dice::rdf::Triple> unused;
+		state.setOutput(unused);
+		for (std::size_t line = begin; line < end;) {
+			std::size_t pos = line;
+			while (pos < end and (document[pos] == ' ' or document[pos] == '\t'))
+				++pos;
+			std::size_t next = document.find('\n', pos);
+			next = next == std::string_view::npos ? document.size() : next + 1;
+			if (pos < end and boundary::startsWithDirective(document.substr(pos, 8))) {
+				boundary::Input in(document.data() + pos, document.data() + document.size(), "directive");
+				try {
+					if (tao::pegtl::parse<Grammar::directive, Actions::action, control>(in, state))
+						next = std::max(next, static_cast<std::size_t>(in.current() - document.data()));
+				} catch (const tao::pegtl::parse_error &) {
+				}
+			}
+			line = next;
+		}
+		const std::size_t blank_node_label = context.blank_node_label;
+		context = States::StatementContext::of(state);
+		context.blank_node_label = blank_node_label;
+	}
+}// namespace Dice::rdf_parser::internal::Turtle::Parsers
+
+#endif//RDF_PARSER_STATEMENTBOUNDARY_HPP
@@ -0,0 +1,120 @@
+#ifndef RDF_PARSER_STATEMENTGENERATOR_HPP
+#define RDF_PARSER_STATEMENTGENERATOR_HPP
+
+/**
+ * Parses an input statement by statement inside a coroutine and yields the triples of each statement.
+ * Parsing only continues when the consumer asks for the next triple, in the consumer's thread. The memory needed is
+ * that of the input buffer and of the triples of one statement. Destroying the generator abandons the rest of the input.
+ */
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Dice/rdf-parser/InputSource.hpp"
+#include "Dice/rdf-parser/ParserStatistics.hpp"
+#include "Dice/rdf-parser/exception/RDFParsingExecption.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Actions/Actions.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Configurations.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Control.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Inputs/GrowingBufferInput.hpp"
+#include "Dice/rdf-parser/internal/Turtle/States/StatementContext.hpp"
+#include "Dice/rdf-parser/internal/Turtle/States/VectorState.hpp"
+#include "Dice/rdf-parser/internal/util/Generator.hpp"
+#include "Dice/rdf-parser/internal/util/InputOffset.hpp"
+#include "Dice/rdf-parser/internal/util/ParseErrors.hpp"
+
+namespace Dice::rdf_parser::internal::Turtle::Parsers {
+
+	/**
+	 * @param input the input; it is owned by the coroutine
+	 * @param context prefixes, base and blank node counter at the begin of the input
+	 * @param statistics counters of the parser, if any; they must outlive the generator
+	 * @throws exception::RDFParsingException when the iteration reaches an invalid statement
+	 */
+	template<typename Input>
+	util::Generator<Dice::rdf::Triple> generateTriples(std::unique_ptr<Input> input,
+													   States::StatementContext context = {},
+													   ParserStatistics *statistics = nullptr) {
+		using RDFParsingException = ::Dice::rdf_parser::exception::RDFParsingException;
+		States::VectorState<false> state;
+		context.applyTo(state);
+		std::vector<Dice::rdf::Triple> triples;
+		state.setOutput(triples);
+		if (statistics != nullptr) {
+			state.recordStatistics(*statistics);
+			if constexpr (requires { input->recordStatistics(*statistics); })
+				input->recordStatistics(*statistics);
+			if constexpr (requires { input->begin(); })
+				statistics->bytes_total.store(static_cast<std::uint64_t>(input->end() - input->begin()), std::memory_order_relaxed);
+		}
+
+		auto translate = [&](const tao::pegtl::parse_error &e) {
+			if constexpr (requires { input->begin(); })
+				return util::fromParseError(e, std::string_view(input->begin(), input->end() - input->begin()));
+			else
+				return util::fromParseError(e);
+		};
+
+		for (;;) {
+			try {
+				tao::pegtl::parse<Grammar::ignored>(*input);
+				if (input->empty()) {
+					if (statistics != nullptr)
+						statistics->bytes_consumed.store(util::inputOffset(*input), std::memory_order_relaxed);
+					break;
+				}
+				if (not tao::pegtl::parse<Grammar::statement, Actions::action, control>(*input, state))
+					throw tao::pegtl::parse_error("invalid statement", *input);
+				// the statement is consumed; a stream input can drop it from its buffer
+				input->discard();
+			} catch (const tao::pegtl::parse_error &e) {
+				if (statistics != nullptr)
+					statistics->finish();
+				throw translate(e);
+			} catch (const RDFParsingException &) {
+				if (statistics != nullptr)
+					statistics->finish();
+				throw;
+			} catch (const std::exception &e) {
+				if (statistics != nullptr)
+					statistics->finish();
+				throw RDFParsingException(e.what());
+			}
+			for (auto &triple : triples)
+				co_yield triple;
+			triples.clear();
+		}
+		if (statistics != nullptr)
+			statistics->finish();
+	}
+
+	/**
+	 * Generates the triples of a source. Contiguous sources are parsed in place; others are read into a buffer that
+	 * holds the current statement only.
+	 */
+	template<InputSource Source>
+	util::Generator<Dice::rdf::Triple> generateTriplesFromSource(Source source,
+																 States::StatementContext context = {},
+																 ParserStatistics *statistics = nullptr) {
+		if constexpr (ContiguousInputSource<Source>) {
+			const std::string_view data = source.contiguous();
+			return generateTriples(std::make_unique<tao::pegtl::memory_input<tao::pegtl::tracking_mode::lazy>>(data.data(), data.size(), source.name()),
+								   std::move(context), statistics);
+		} else {
+			using Reader = std::function<std::size_t(char *buffer, std::size_t length)>;
+			auto shared_source = std::make_shared<Source>(std::move(source));
+			return generateTriples(std::make_unique<Inputs::GrowingBufferInput<Reader>>(
+										   shared_source->name(),
+										   Configurations::RdfConcurrentStreamParser_BufferSize,
+										   Configurations::RdfConcurrentStreamParser_MaxBufferSize,
+										   [shared_source](char *buffer, std::size_t length) { return shared_source->read(buffer, length); }),
+								   std::move(context), statistics);
+		}
+	}
+}// namespace Dice::rdf_parser::internal::Turtle::Parsers
+
+#endif//RDF_PARSER_STATEMENTGENERATOR_HPP
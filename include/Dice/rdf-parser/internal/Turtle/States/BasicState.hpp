@@ -50,7 +50,7 @@ namespace Dice::rdf_parser::internal::Turtle::States {
 		//dealing with base directives
 		std::string base_;
 
-		int latest_BN_label = 1;
+		std::size_t latest_BN_label = 1;
 
 		// todo: use something optimized
 		robin_hood::unordered_map<std::string, std::string> prefix_map;
@@ -122,11 +122,20 @@ namespace Dice::rdf_parser::internal::Turtle::States {
 
 		const std::string &getBase() { return base_; }
 
+		[[nodiscard]] const robin_hood::unordered_map<std::string, std::string> &getPrefixMap() const { return prefix_map; }
+
 		// create a unique label for a BlankNode
 		std::string createBlankNodeLabel() {
 			return fmt::format("b{}", latest_BN_label++);
 		}
 
+		/**
+		 * Allows parsing a statement again with the same blank node labels.
+		 */
+		[[nodiscard]] std::size_t blankNodeLabelCount() const { return latest_BN_label; }
+
+		void resetBlankNodeLabelCount(std::size_t count) { latest_BN_label = count; }
+
 		[[nodiscard]] inline std::optional<std::reference_wrapper<const std::string>>
 		getPrefixValue(const std::string &prefix) const {
 			if (auto prefix_iter = prefix_map.find(prefix);
@@ -0,0 +1,68 @@
+#ifndef RDF_PARSER_BATCHSTATE_HPP
+#define RDF_PARSER_BATCHSTATE_HPP
+
+/**
+States store information needed during and after the parsing.
+For more information about states please check https://github.com/taocpp/PEGTL/blob/master/doc/Actions-and-States.md#states
+
+*/
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "Dice/rdf-parser/internal/Turtle/States/State.hpp"
+
+namespace Dice::rdf_parser::internal::Turtle::States {
+
+	/*
+     * BatchState collects parsed triples into batches and hands every full batch to a callback.
+     * Batches are only handed over between statements and once more when the document is done.
+     */
+	template<bool sparqlQuery>
+	class BatchState : public State<sparqlQuery, BatchState<sparqlQuery>> {
+		using Triple = Dice::rdf::Triple;
+		using TriplePattern = Dice::sparql::TriplePattern;
+		using Triple_t = std::conditional_t<sparqlQuery, TriplePattern, Triple>;
+
+	public:
+		using Batch = std::vector<Triple_t>;
+
+	private:
+		Batch batch;
+		std::size_t batch_size;
+		std::function<void(Batch &&)> flush;
+
+		void handOver() {
+			flush(std::move(batch));
+			batch = Batch{};
+			batch.reserve(batch_size);
+		}
+
+	public:
+		/**
+		 * @param batch_size number of triples after which a batch is handed over
+		 * @param flush receives the batches
+		 */
+		BatchState(std::size_t batch_size, std::function<void(Batch &&)> flush)
+			: batch_size(batch_size), flush(std::move(flush)) {
+			batch.reserve(batch_size);
+		}
+
+		inline void syncWithMainThread_impl() {
+			if (batch.size() >= batch_size)
+				handOver();
+		}
+
+		inline void insertTriple_impl(Triple_t triple) {
+			batch.push_back(std::move(triple));
+		}
+
+		void setParsingIsDone_impl() {
+			if (not batch.empty())
+				handOver();
+		}
+	};
+}// namespace Dice::rdf_parser::internal::Turtle::States
+
+#endif//RDF_PARSER_BATCHSTATE_HPP
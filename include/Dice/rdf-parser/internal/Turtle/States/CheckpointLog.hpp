@@ -0,0 +1,95 @@
+#ifndef RDF_PARSER_CHECKPOINTLOG_HPP
+#define RDF_PARSER_CHECKPOINTLOG_HPP
+
+/**
+ * Hands checkpoints from the parsing thread to the consumer of a concurrent parser.
+ * The parsing thread records a checkpoint after a statement when one was requested or the interval has passed.
+ * The consumer asks for the checkpoint at the number of triples it has taken; checkpoints it has passed are dropped.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "Dice/rdf-parser/Checkpoint.hpp"
+
+namespace Dice::rdf_parser::internal::Turtle::States {
+
+	class CheckpointLog {
+		// checkpoints that the consumer has not passed yet are few; this bounds them if the consumer never asks
+		static constexpr std::size_t max_pending = 1024;
+
+		Checkpoint start_;
+		std::mutex m_;
+		std::deque<Checkpoint> pending_;
+		std::atomic_size_t interval_{0};
+		std::atomic_bool requested_{false};
+		// used by the parsing thread only
+		std::size_t next_offset_ = 0;
+
+	public:
+		/**
+		 * @param start the checkpoint the parse starts at; offsets and triple counts are continued from it
+		 */
+		explicit CheckpointLog(Checkpoint start = {}) : start_{std::move(start)} {}
+
+		[[nodiscard]] const Checkpoint &start() const noexcept { return start_; }
+
+		/**
+		 * Records a checkpoint whenever at least bytes were parsed since the last one; 0 records only on request.
+		 */
+		void every(std::size_t bytes) noexcept { interval_ = bytes; }
+
+		/**
+		 * Records a checkpoint after the statement the parsing thread currently parses.
+		 */
+		void request() noexcept { requested_ = true; }
+
+		/**
+		 * @param offset offset after the statement that was just parsed, relative to the start
+		 * @return whether a checkpoint is to be recorded there
+		 */
+		[[nodiscard]] bool due(std::size_t offset) const noexcept {
+			if (requested_.load(std::memory_order_relaxed))
+				return true;
+			const std::size_t interval = interval_.load(std::memory_order_relaxed);
+			return interval != 0 and offset >= next_offset_;
+		}
+
+		/**
+		 * Called by the parsing thread.
+		 * @param offset offset after the statement, relative to the start
+		 * @param triples triples parsed up to offset, relative to the start
+		 */
+		void record(std::size_t offset, std::size_t triples, StatementContext context) {
+			requested_ = false;
+			next_offset_ = offset + interval_.load(std::memory_order_relaxed);
+			std::lock_guard<std::mutex> lk(m_);
+			if (pending_.size() == max_pending)
+				pending_.pop_front();
+			pending_.push_back({start_.offset + offset, start_.triples + triples, std::move(context)});
+		}
+
+		/**
+		 * Called by the consumer.
+		 * @param delivered triples the consumer has taken, relative to the start
+		 * @return the checkpoint after exactly these triples, if one was recorded
+		 */
+		std::optional<Checkpoint> at(std::size_t delivered) {
+			const std::size_t triples = start_.triples + delivered;
+			std::lock_guard<std::mutex> lk(m_);
+			// statements without triples, e.g. directives, share the count; the last one is the furthest
+			while (not pending_.empty() and (pending_.front().triples < triples or
+											  (pending_.size() > 1 and pending_[1].triples == triples)))
+				pending_.pop_front();
+			if (pending_.empty() or pending_.front().triples != triples)
+				return std::nullopt;
+			return pending_.front();
+		}
+	};
+}// namespace Dice::rdf_parser::internal::Turtle::States
+
+#endif//RDF_PARSER_CHECKPOINTLOG_HPP
@@ -12,14 +12,22 @@ For more information about states please check https://github.com/taocpp/PEGTL/b
 #include <mutex>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include <boost/lockfree/spsc_queue.hpp>
 
+#include "Dice/rdf-parser/CancellationToken.hpp"
 #include "Dice/rdf-parser/internal/Turtle/Configurations.hpp"
+#include "Dice/rdf-parser/internal/Turtle/States/CheckpointLog.hpp"
 #include "Dice/rdf-parser/internal/Turtle/States/State.hpp"
 
 namespace Dice::rdf_parser::internal::Turtle::States {
 
+	/*
+     * thrown by ConcurrentState between statements to end the parsing when it was cancelled or the limit is reached
+     */
+	struct ParsingStopped {};
+
 	/*
      * ConcurrentState deal with the logic of Concurrent parsing  (already parsed triples can be accessed during the parsing).
      */
@@ -41,9 +49,36 @@ namespace Dice::rdf_parser::internal::Turtle::States {
 		std::atomic_bool &termCountWithinThresholds;
 		std::atomic_bool &termsCountIsNotEmpty;
 		std::atomic_bool &parsingIsDone;
+		const CancellationToken &cancellation;
+		// maximal number of triples to parse
+		const std::atomic_size_t &limit;
+		std::size_t inserted = 0;
+		// triples of a statement were dropped because of the limit, so no checkpoint may follow
+		bool dropped = false;
+		CheckpointLog &checkpoints;
+		// while errors are recovered from, the triples of a statement are held back until it is complete
+		const bool recover;
+		bool staging;
+		std::vector<Triple_t> staged;
 
 		boost::lockfree::spsc_queue<Triple_t> &parsed_elements;
 
+		[[nodiscard]] bool stopRequested() const noexcept {
+			return cancellation.cancelled() or inserted >= limit.load(std::memory_order_relaxed);
+		}
+
+		void publish(Triple_t &&triple) {
+			// the triple is pushed before the consumer is woken, so it finds it
+			this->parsed_elements.push(std::move(triple));
+			if (not termsCountIsNotEmpty) {
+				{
+					std::lock_guard<std::mutex> lk(m2);
+					termsCountIsNotEmpty = true;
+				}
+				cv2.notify_one();
+			}
+		}
+
 	public:
 		explicit ConcurrentState(
 				boost::lockfree::spsc_queue<Triple_t> &parsingQueue,
@@ -52,48 +87,93 @@ namespace Dice::rdf_parser::internal::Turtle::States {
 				std::condition_variable &cv2, std::mutex &m2,
 				std::atomic_bool &termCountWithinThresholds,
 				std::atomic_bool &termsCountIsNotEmpty,
-				std::atomic_bool &parsingIsDone)
+				std::atomic_bool &parsingIsDone,
+				const CancellationToken &cancellation,
+				const std::atomic_size_t &limit,
+				CheckpointLog &checkpoints,
+				bool recover)
 			: parsed_elements(parsingQueue),
 			  upperThreshold(upperThreshold),
 			  cv(cv), m(m),
 			  cv2(cv2), m2(m2),
 			  termCountWithinThresholds(termCountWithinThresholds),
 			  termsCountIsNotEmpty(termsCountIsNotEmpty),
-			  parsingIsDone(parsingIsDone) {}
+			  parsingIsDone(parsingIsDone),
+			  cancellation(cancellation),
+			  limit(limit),
+			  checkpoints(checkpoints),
+			  recover(recover),
+			  staging(recover) {
+			checkpoints.start().context.applyTo(*this);
+		}
+
+		/**
+		 * Called after every statement, before syncWithMainThread. Hands over held back triples and records a checkpoint if one is due.
+		 * @param in the statement; the input tracks positions eagerly
+		 */
+		template<typename Input>
+		void statementParsed(const Input &in) {
+			for (auto &triple : staged)
+				publish(std::move(triple));
+			staged.clear();
+			staging = recover;
+			// the statement itself may already be discarded from the buffer, so its end is taken from the input
+			const std::size_t offset = in.input().byte();
+			if (not dropped and checkpoints.due(offset))
+				checkpoints.record(offset, inserted, StatementContext::of(*this));
+		}
 
+		/**
+		 * Called after every statement.
+		 * @throws ParsingStopped if the parsing was cancelled or the limit is reached
+		 */
 		inline void syncWithMainThread_impl() {
+			if (stopRequested())
+				throw ParsingStopped{};
 			if (this->parsed_elements.read_available() > upperThreshold) {
 				std::unique_lock<std::mutex> lk(m);
 				termCountWithinThresholds = false;
-				//set the parsing thread to sleep
-				cv.wait(lk, [&] { return termCountWithinThresholds.load(); });
+				//set the parsing thread to sleep. The parser wakes it up when it needs more triples or is cancelled.
+				util::ScopedNanoseconds blocked{this->statistics_ != nullptr ? &this->statistics_->blocked_on_full_queue_nanoseconds : nullptr};
+				cv.wait(lk, [&] { return termCountWithinThresholds.load() or stopRequested(); });
 				//the parsing thread wake from sleeping
+				if (stopRequested())
+					throw ParsingStopped{};
 			}
 		}
 
 		inline void insertTriple_impl(Triple_t triple) {
-			if (not termsCountIsNotEmpty) {
-				{
-					std::lock_guard<std::mutex> lk(m2);
-					termsCountIsNotEmpty = true;
-				}
-				this->parsed_elements.push(std::move(triple));
-				cv2.notify_one();
-			} else {
-				this->parsed_elements.push(std::move(triple));
+			// triples of the last statement beyond the limit are dropped
+			if (inserted >= limit.load(std::memory_order_relaxed)) {
+				dropped = true;
+				return;
 			}
+			++inserted;
+			if (staging)
+				staged.push_back(std::move(triple));
+			else
+				publish(std::move(triple));
+		}
+
+		/**
+		 * Drops an invalid statement, including its held back triples, before the parsing continues after it.
+		 */
+		void discardInvalidStatement() {
+			inserted -= staged.size();
+			staged.clear();
+			this->discardStatement();
+			staging = recover;
 		}
 
 
 		void setParsingIsDone_impl() {
-			if (not termsCountIsNotEmpty) {
-				{
-					std::lock_guard<std::mutex> lk(m2);
-					termsCountIsNotEmpty = true;
-				}
-				cv2.notify_one();
-			}
+			// the consumer is always woken; it may have started waiting after termsCountIsNotEmpty was read
 			parsingIsDone = true;
+			{
+				std::lock_guard<std::mutex> lk(m2);
+				termsCountIsNotEmpty = true;
+			}
+			cv2.notify_one();
 		}
 	};
 
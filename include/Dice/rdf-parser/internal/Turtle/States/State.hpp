@@ -7,12 +7,18 @@ For more information about states please check https://github.com/taocpp/PEGTL/b
 
 */
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <queue>
 #include <stack>
 
 #include "Dice/RDF/Triple.hpp"
 #include "Dice/SPARQL/TriplePattern.hpp"
+#include "Dice/rdf-parser/ParserStatistics.hpp"
+#include "Dice/rdf-parser/internal/Turtle/Configurations.hpp"
 #include "Dice/rdf-parser/internal/Turtle/States/BasicState.hpp"
+#include "Dice/rdf-parser/internal/util/InputOffset.hpp"
 
 
 namespace Dice::rdf_parser::internal::Turtle::States {
@@ -63,14 +69,91 @@ namespace Dice::rdf_parser::internal::Turtle::States {
 		//to deal with the case when there are BNPL + optional predicateObjectList
 		Element_t first_BNPL;
 
+		// statistics of the parser; nothing is counted if it is null
+		ParserStatistics *statistics_ = nullptr;
+		// offset of the end of the last counted statement in the current input
+		std::size_t counted_offset_ = 0;
+		std::uint64_t statement_triples_ = 0;
+		// statements until the next one is timed
+		std::size_t statements_until_sample_ = Configurations::ParserStatistics_SampleInterval;
+		bool timing_actions_ = false;
+		std::chrono::steady_clock::time_point sample_start_;
+		std::uint64_t sampled_action_nanoseconds_ = 0;
+
 
 	public:
 		inline void syncWithMainThread() { static_cast<Derived *>(this)->syncWithMainThread_impl(); };
 
-		inline void insertTriple(Triple_t triple) { return static_cast<Derived *>(this)->insertTriple_impl(triple); };
+		inline void insertTriple(Triple_t triple) {
+			++statement_triples_;
+			return static_cast<Derived *>(this)->insertTriple_impl(triple);
+		};
 
 		void setParsingIsDone() { static_cast<Derived *>(this)->setParsingIsDone_impl(); };
 
+		/**
+		 * Counts the statements, triples and consumed bytes of this state in statistics.
+		 * @param input_offset offset of the current position of the input, if parsing starts within it
+		 */
+		void recordStatistics(ParserStatistics &statistics, std::size_t input_offset = 0) noexcept {
+			statistics_ = &statistics;
+			counted_offset_ = input_offset;
+		}
+
+		[[nodiscard]] ParserStatistics *statistics() const noexcept { return statistics_; }
+
+		/**
+		 * Called by the control class when a statement starts. Every few statements one is timed.
+		 */
+		inline void statementStarted() {
+			if (statistics_ == nullptr)
+				return;
+			// a statement that failed before is timed again
+			if (not timing_actions_ and --statements_until_sample_ != 0)
+				return;
+			statements_until_sample_ = Configurations::ParserStatistics_SampleInterval;
+			timing_actions_ = true;
+			sampled_action_nanoseconds_ = 0;
+			sample_start_ = std::chrono::steady_clock::now();
+		}
+
+		/**
+		 * @return whether the actions of the current statement are timed
+		 */
+		[[nodiscard]] bool timingActions() const noexcept { return timing_actions_; }
+
+		inline void addActionNanoseconds(std::uint64_t nanoseconds) noexcept { sampled_action_nanoseconds_ += nanoseconds; }
+
+		/**
+		 * Called after every statement, before syncWithMainThread, so waiting for the consumer is not timed as parsing.
+		 * @param in the statement
+		 */
+		template<typename Input>
+		void countStatement(const Input &in) {
+			if (statistics_ == nullptr)
+				return;
+			constexpr auto relaxed = std::memory_order_relaxed;
+			// the statement itself may already be discarded from a stream buffer, so its end is taken from the input
+			const std::size_t offset = util::inputOffset(in.input());
+			statistics_->bytes_consumed.fetch_add(offset - std::min(counted_offset_, offset), relaxed);
+			counted_offset_ = offset;
+			statistics_->statements.fetch_add(1, relaxed);
+			// directives are the only statements without triples
+			if (statement_triples_ == 0)
+				statistics_->directives.fetch_add(1, relaxed);
+			else
+				statistics_->triples.fetch_add(statement_triples_, relaxed);
+			statement_triples_ = 0;
+			if (timing_actions_) {
+				timing_actions_ = false;
+				const auto elapsed = static_cast<std::uint64_t>(
+						std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - sample_start_).count());
+				const std::uint64_t actions = std::min(sampled_action_nanoseconds_, elapsed);
+				statistics_->grammar_nanoseconds.fetch_add((elapsed - actions) * Configurations::ParserStatistics_SampleInterval, relaxed);
+				statistics_->action_nanoseconds.fetch_add(actions * Configurations::ParserStatistics_SampleInterval, relaxed);
+			}
+		}
+
 
 		inline void clearTripleParameters() {
 			verb_stack_two_step_pre_size = 0;
@@ -80,6 +163,17 @@ namespace Dice::rdf_parser::internal::Turtle::States {
 			bnpl_collection_list.clear();
 		}
 
+		/**
+		 * Drops everything collected for a statement that was not parsed completely.
+		 */
+		inline void discardStatement() {
+			statement_triples_ = 0;
+			clearTripleParameters();
+			verb_stack = {};
+			bnpl_collection_list_stack = {};
+			verb_object_pair_list_stack = {};
+		}
+
 
 		inline void setSubject(Element_t subject) {
 			this->subject_ = std::move(subject);
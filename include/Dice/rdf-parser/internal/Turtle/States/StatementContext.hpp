@@ -0,0 +1,40 @@
+#ifndef RDF_PARSER_STATEMENTCONTEXT_HPP
+#define RDF_PARSER_STATEMENTCONTEXT_HPP
+
+/**
+ * The part of a state that carries over from one statement to the next: prefixes, base and the counter for blank node labels.
+ * A parse that starts in the middle of a document is set up with the context at its start.
+ */
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include <robin_hood.h>
+
+#include "Dice/rdf-parser/internal/Turtle/States/BasicState.hpp"
+
+namespace Dice::rdf_parser::internal::Turtle::States {
+
+	struct StatementContext {
+		robin_hood::unordered_map<std::string, std::string> prefixes;
+		std::string base;
+		std::size_t blank_node_label = 1;
+
+		template<bool sparqlQuery>
+		void applyTo(BasicState<sparqlQuery> &state) const {
+			for (const auto &pair : prefixes)
+				state.addPrefix(pair.first, pair.second);
+			if (not base.empty())
+				state.setBase(base);
+			state.resetBlankNodeLabelCount(blank_node_label);
+		}
+
+		template<bool sparqlQuery>
+		static StatementContext of(BasicState<sparqlQuery> &state) {
+			return {state.getPrefixMap(), state.getBase(), state.blankNodeLabelCount()};
+		}
+	};
+}// namespace Dice::rdf_parser::internal::Turtle::States
+
+#endif//RDF_PARSER_STATEMENTCONTEXT_HPP
@@ -0,0 +1,48 @@
+#ifndef RDF_PARSER_VECTORSTATE_HPP
+#define RDF_PARSER_VECTORSTATE_HPP
+
+/**
+States store information needed during and after the parsing.
+For more information about states please check https://github.com/taocpp/PEGTL/blob/master/doc/Actions-and-States.md#states
+
+*/
+
+#include <vector>
+
+#include "Dice/rdf-parser/internal/Turtle/States/State.hpp"
+
+namespace Dice::rdf_parser::internal::Turtle::States {
+
+	/*
+     * VectorState appends parsed triples to a vector owned by the caller. The vector can be changed between statements,
+     * so one state (with its prefixes and base) can be used for a document that is parsed piece by piece.
+     */
+	template<bool sparqlQuery>
+	class VectorState : public State<sparqlQuery, VectorState<sparqlQuery>> {
+		using Triple = Dice::rdf::Triple;
+		using TriplePattern = Dice::sparql::TriplePattern;
+		using Triple_t = std::conditional_t<sparqlQuery, TriplePattern, Triple>;
+
+	private:
+		std::vector<Triple_t> *parsed_elements = nullptr;
+
+	public:
+		VectorState() = default;
+
+		inline void setOutput(std::vector<Triple_t> &output) {
+			parsed_elements = &output;
+		}
+
+		inline void syncWithMainThread_impl() {
+		}
+
+		inline void insertTriple_impl(Triple_t triple) {
+			parsed_elements->push_back(std::move(triple));
+		}
+
+		void setParsingIsDone_impl() {
+		}
+	};
+}// namespace Dice::rdf_parser::internal::Turtle::States
+
+#endif//RDF_PARSER_VECTORSTATE_HPP
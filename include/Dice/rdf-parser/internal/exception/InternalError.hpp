@@ -1,6 +1,8 @@
 #ifndef RDF_PARSER_INTERNALERROR_HPP
 #define RDF_PARSER_INTERNALERROR_HPP
 
+#include <exception>
+
 namespace Dice::rdf_parser::internal::exception {
 	class InternalError : public std::exception {
 	public:
@@ -0,0 +1,273 @@
+#ifndef RDF_PARSER_ARCHIVE_HPP
+#define RDF_PARSER_ARCHIVE_HPP
+
+/**
+ * Reading members of ZIP and tar archives that are mapped into memory, without extracting them to disk.
+ * ZIP members may be stored or deflated; ZIP64 archives are supported. tar archives may use ustar, GNU long names and pax paths.
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <zlib.h>
+
+namespace Dice::rdf_parser::internal::util {
+
+	enum struct ArchiveFormat {
+		None,
+		Zip,
+		Tar
+	};
+
+	struct ArchiveMember {
+		enum struct Method {
+			Stored,
+			Deflated
+		};
+
+		std::string name;
+		// the data of the member as it is stored in the archive
+		std::string_view data;
+		Method method = Method::Stored;
+		std::size_t size = 0;
+	};
+
+	namespace archive {
+		inline std::uint64_t readLittleEndian(const char *data, std::size_t bytes) noexcept {
+			std::uint64_t value = 0;
+			for (std::size_t i = bytes; i-- > 0;)
+				value = (value << 8) | static_cast<unsigned char>(data[i]);
+			return value;
+		}
+
+		/**
+		 * @return whether [offset, offset + length) lies within an archive of the given size; offsets read from a
+		 * corrupt archive may be so large that offset + length wraps around, so it is not computed
+		 */
+		inline bool fits(std::uint64_t offset, std::uint64_t length, std::size_t size) noexcept {
+			return offset <= size and length <= size - offset;
+		}
+
+		inline void check(bool condition, const char *what) {
+			if (not condition)
+				throw std::runtime_error{std::string{"corrupt archive: "} + what};
+		}
+
+		inline std::vector<ArchiveMember> listZipMembers(std::string_view archive) {
+			constexpr std::size_t eocd_size = 22;
+			check(archive.size() >= eocd_size, "too small");
+			// the end of central directory record is followed by a comment of at most 64 KiB
+			std::size_t eocd = archive.size() - eocd_size;
+			const std::size_t search_end = archive.size() > eocd_size + 0xffff ? archive.size() - eocd_size - 0xffff : 0;
+			while (readLittleEndian(archive.data() + eocd, 4) != 0x06054b50) {
+				check(eocd > search_end, "end of central directory not found");
+				--eocd;
+			}
+			std::uint64_t entries = readLittleEndian(archive.data() + eocd + 10, 2);
+			std::uint64_t directory = readLittleEndian(archive.data() + eocd + 16, 4);
+			if ((entries == 0xffff or directory == 0xffffffff) and eocd >= 20 and
+				readLittleEndian(archive.data() + eocd - 20, 4) == 0x07064b50) {
+				const std::uint64_t zip64_eocd = readLittleEndian(archive.data() + eocd - 20 + 8, 8);
+				check(fits(zip64_eocd, 56, archive.size()) and readLittleEndian(archive.data() + zip64_eocd, 4) == 0x06064b50, "ZIP64 end of central directory");
+				entries = readLittleEndian(archive.data() + zip64_eocd + 32, 8);
+				directory = readLittleEndian(archive.data() + zip64_eocd + 48, 8);
+			}
+
+			std::vector<ArchiveMember> members;
+			std::uint64_t pos = directory;
+			for (std::uint64_t i = 0; i < entries; ++i) {
+				check(fits(pos, 46, archive.size()) and readLittleEndian(archive.data() + pos, 4) == 0x02014b50, "central directory header");
+				const char *header = archive.data() + pos;
+				const auto flags = readLittleEndian(header + 8, 2);
+				const auto method = readLittleEndian(header + 10, 2);
+				std::uint64_t compressed_size = readLittleEndian(header + 20, 4);
+				std::uint64_t size = readLittleEndian(header + 24, 4);
+				const auto name_length = readLittleEndian(header + 28, 2);
+				const auto extra_length = readLittleEndian(header + 30, 2);
+				const auto comment_length = readLittleEndian(header + 32, 2);
+				std::uint64_t local_header = readLittleEndian(header + 42, 4);
+				check(fits(pos, 46 + name_length + extra_length + comment_length, archive.size()), "central directory header");
+				std::string name{header + 46, name_length};
+
+				// the ZIP64 extra field holds the values that are saturated in the header, in this order
+				// a field that claims to be longer than the extra fields is cut at their end
+				for (std::string_view extras{header + 46 + name_length, extra_length}; extras.size() >= 4;) {
+					const auto id = readLittleEndian(extras.data(), 2);
+					const auto length = readLittleEndian(extras.data() + 2, 2);
+					if (id == 0x0001) {
+						std::string_view value = extras.substr(4, length);
+						for (std::uint64_t *field : {&size, &compressed_size, &local_header}) {
+							if (*field == 0xffffffff and value.size() >= 8) {
+								*field = readLittleEndian(value.data(), 8);
+								value.remove_prefix(8);
+							}
+						}
+					}
+					extras.remove_prefix(std::min<std::size_t>(extras.size(), 4 + length));
+				}
+				pos += 46 + name_length + extra_length + comment_length;
+
+				if (name.empty() or name.back() == '/')
+					continue;
+				if (flags & 1)
+					throw std::runtime_error{"encrypted archive member " + name + " is not supported"};
+				if (method != 0 and method != 8)
+					throw std::runtime_error{"compression method " + std::to_string(method) + " of archive member " + name + " is not supported"};
+
+				check(fits(local_header, 30, archive.size()) and readLittleEndian(archive.data() + local_header, 4) == 0x04034b50, "local file header");
+				const std::uint64_t data = local_header + 30 + readLittleEndian(archive.data() + local_header + 26, 2) + readLittleEndian(archive.data() + local_header + 28, 2);
+				check(fits(data, compressed_size, archive.size()), "member exceeds the archive");
+				members.push_back({std::move(name),
+								   archive.substr(data, compressed_size),
+								   method == 0 ? ArchiveMember::Method::Stored : ArchiveMember::Method::Deflated,
+								   size});
+			}
+			return members;
+		}
+
+		inline std::uint64_t tarNumber(const char *field, std::size_t length) {
+			// GNU base-256 encoding for sizes of 8 GiB and more
+			if (static_cast<unsigned char>(field[0]) & 0x80) {
+				std::uint64_t value = static_cast<unsigned char>(field[0]) & 0x7f;
+				for (std::size_t i = 1; i < length; ++i)
+					value = (value << 8) | static_cast<unsigned char>(field[i]);
+				return value;
+			}
+			std::uint64_t value = 0;
+			for (std::size_t i = 0; i < length and field[i] != '\0' and field[i] != ' '; ++i) {
+				check(field[i] >= '0' and field[i] <= '7', "tar number");
+				value = value * 8 + static_cast<std::uint64_t>(field[i] - '0');
+			}
+			return value;
+		}
+
+		inline std::string tarString(const char *field, std::size_t length) {
+			std::size_t end = 0;
+			while (end < length and field[end] != '\0')
+				++end;
+			return {field, end};
+		}
+
+		inline std::string paxPath(std::string_view records) {
+			std::string path;
+			// records have the form "<length> <key>=<value>\n"
+			while (not records.empty()) {
+				const auto space = records.find(' ');
+				check(space != std::string_view::npos, "pax header");
+				const std::size_t length = std::stoul(std::string{records.substr(0, space)});
+				check(length > space + 1 and length <= records.size(), "pax header");
+				const auto record = records.substr(space + 1, length - space - 2);
+				if (record.substr(0, 5) == "path=")
+					path = record.substr(5);
+				records.remove_prefix(length);
+			}
+			return path;
+		}
+
+		inline std::vector<ArchiveMember> listTarMembers(std::string_view archive) {
+			constexpr std::size_t block = 512;
+			std::vector<ArchiveMember> members;
+			std::string long_name;
+			for (std::size_t pos = 0; pos + block <= archive.size();) {
+				const char *header = archive.data() + pos;
+				// the archive ends with zero blocks
+				if (header[0] == '\0')
+					break;
+				const std::uint64_t size = tarNumber(header + 124, 12);
+				const char type = header[156];
+				const std::size_t data = pos + block;
+				check(fits(data, size, archive.size()), "member exceeds the archive");
+				const auto content = archive.substr(data, size);
+				pos = data + (size + block - 1) / block * block;
+
+				if (type == 'L') {
+					long_name = tarString(content.data(), content.size());
+				} else if (type == 'x') {
+					long_name = paxPath(content);
+				} else if (type == '0' or type == '\0' or type == '7') {
+					std::string name;
+					if (not long_name.empty()) {
+						name = std::move(long_name);
+						long_name.clear();
+					} else {
+						name = tarString(header, 100);
+						if (const auto prefix = tarString(header + 345, 155); not prefix.empty() and std::string_view{header + 257, 5} == "ustar")
+							name = prefix + '/' + name;
+					}
+					members.push_back({std::move(name), content, ArchiveMember::Method::Stored, size});
+				} else {
+					// directories, links and global headers carry no documents
+					long_name.clear();
+				}
+			}
+			return members;
+		}
+	}// namespace archive
+
+	/**
+	 * Detects ZIP and tar archives by their signatures.
+	 */
+	inline ArchiveFormat detectArchive(std::string_view data) noexcept {
+		if (data.substr(0, 4) == std::string_view{"PK\x03\x04", 4} or data.substr(0, 4) == std::string_view{"PK\x05\x06", 4})
+			return ArchiveFormat::Zip;
+		if (data.size() >= 512 and data.substr(257, 5) == "ustar")
+			return ArchiveFormat::Tar;
+		return ArchiveFormat::None;
+	}
+
+	/**
+	 * Lists the regular files of an archive in the order they are stored.
+	 */
+	inline std::vector<ArchiveMember> listArchiveMembers(std::string_view archive, ArchiveFormat format) {
+		switch (format) {
+			case ArchiveFormat::Zip:
+				return archive::listZipMembers(archive);
+			case ArchiveFormat::Tar:
+				return archive::listTarMembers(archive);
+			default:
+				throw std::invalid_argument{"not an archive"};
+		}
+	}
+
+	/**
+	 * Decompresses a deflated member into out. Stored members need no copy; use member.data directly.
+	 */
+	inline void inflateMember(const ArchiveMember &member, std::string &out) {
+		z_stream stream{};
+		// negative window bits: raw deflate data without header
+		if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+			throw std::runtime_error{"cannot initialize zlib"};
+		std::unique_ptr<z_stream, decltype(&inflateEnd)> guard{&stream, &inflateEnd};
+		out.resize(member.size);
+		stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(member.data.data()));
+		std::size_t remaining_in = member.data.size();
+		std::size_t produced = 0;
+		for (;;) {
+			if (stream.avail_in == 0 and remaining_in != 0) {
+				stream.avail_in = static_cast<uInt>(std::min<std::size_t>(remaining_in, UINT_MAX));
+				remaining_in -= stream.avail_in;
+			}
+			if (produced == out.size())
+				out.resize(std::max<std::size_t>(out.size() * 2, 64 * 1024));
+			const auto available = static_cast<uInt>(std::min<std::size_t>(out.size() - produced, UINT_MAX));
+			stream.next_out = reinterpret_cast<Bytef *>(out.data() + produced);
+			stream.avail_out = available;
+			const int result = inflate(&stream, Z_NO_FLUSH);
+			produced += available - stream.avail_out;
+			if (result == Z_STREAM_END)
+				break;
+			if (result != Z_OK and not(result == Z_BUF_ERROR and stream.avail_out == 0))
+				throw std::runtime_error{"corrupt archive member " + member.name};
+		}
+		out.resize(produced);
+	}
+}// namespace Dice::rdf_parser::internal::util
+
+#endif//RDF_PARSER_ARCHIVE_HPP
@@ -0,0 +1,80 @@
+#ifndef RDF_PARSER_BINARYFORMAT_HPP
+#define RDF_PARSER_BINARYFORMAT_HPP
+
+/**
+ * Little-endian encoding of numbers and length-prefixed strings for the files the parsers write, e.g. statement indexes
+ * and checkpoints. The encoding does not depend on the platform.
+ */
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#include "Dice/rdf-parser/internal/Turtle/States/StatementContext.hpp"
+
+namespace Dice::rdf_parser::internal::util {
+
+	inline void writeNumber(std::ostream &out, std::uint64_t value) {
+		std::array<char, 8> bytes{};
+		for (auto &byte : bytes) {
+			byte = static_cast<char>(value & 0xff);
+			value >>= 8;
+		}
+		out.write(bytes.data(), bytes.size());
+	}
+
+	inline void writeString(std::ostream &out, const std::string &value) {
+		writeNumber(out, value.size());
+		out.write(value.data(), static_cast<std::streamsize>(value.size()));
+	}
+
+	inline std::uint64_t readNumber(std::istream &in) {
+		std::array<unsigned char, 8> bytes{};
+		in.read(reinterpret_cast<char *>(bytes.data()), bytes.size());
+		std::uint64_t value = 0;
+		for (std::size_t i = bytes.size(); i-- > 0;)
+			value = (value << 8) | bytes[i];
+		return value;
+	}
+
+	inline std::string readString(std::istream &in) {
+		const auto length = readNumber(in);
+		if (not in or length > (std::uint64_t(1) << 32))
+			throw std::runtime_error{"corrupt file: invalid string length"};
+		std::string value(length, '\0');
+		in.read(value.data(), static_cast<std::streamsize>(length));
+		return value;
+	}
+
+	/**
+	 * Writes the whole context: blank node counter, base and all prefixes.
+	 */
+	inline void writeContext(std::ostream &out, const Turtle::States::StatementContext &context) {
+		writeNumber(out, context.blank_node_label);
+		writeString(out, context.base);
+		writeNumber(out, context.prefixes.size());
+		for (const auto &[prefix, value] : context.prefixes) {
+			writeString(out, prefix);
+			writeString(out, value);
+		}
+	}
+
+	inline Turtle::States::StatementContext readContext(std::istream &in) {
+		Turtle::States::StatementContext context;
+		context.blank_node_label = readNumber(in);
+		context.base = readString(in);
+		const auto prefixes = readNumber(in);
+		for (std::uint64_t i = 0; i < prefixes and in; ++i) {
+			auto prefix = readString(in);
+			context.prefixes.emplace(std::move(prefix), readString(in));
+		}
+		if (not in)
+			throw std::runtime_error{"corrupt file: truncated context"};
+		return context;
+	}
+}// namespace Dice::rdf_parser::internal::util
+
+#endif//RDF_PARSER_BINARYFORMAT_HPP
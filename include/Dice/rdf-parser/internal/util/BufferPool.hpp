@@ -0,0 +1,272 @@
+#ifndef RDF_PARSER_BUFFERPOOL_HPP
+#define RDF_PARSER_BUFFERPOOL_HPP
+
+/**
+ * Process wide pool of input buffers shared by all stream parsers.
+ * Parsers borrow a buffer and give it back when they are done, so buffers that already have memory committed are reused
+ * instead of being mapped and faulted in again. The memory used by all buffers together is bounded by a limit.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <iterator>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "Dice/rdf-parser/internal/util/ReservedBuffer.hpp"
+
+namespace Dice::rdf_parser::internal::util {
+
+	class BufferPool {
+	public:
+		struct Options {
+			// upper bound for the memory of all buffers, borrowed and pooled
+			std::size_t memory_limit = std::size_t(8) * 1024 * 1024 * 1024;
+			// how many returned buffers are kept for reuse
+			std::size_t max_pooled_buffers = 8;
+			// how long a buffer waits for memory to grow before giving up
+			std::chrono::milliseconds grow_timeout = std::chrono::seconds(30);
+			// how long acquiring a buffer waits for other buffers to be given back before giving up
+			std::chrono::milliseconds acquire_timeout = std::chrono::seconds(30);
+			HugePages huge_pages = HugePages::None;
+		};
+
+		/**
+		 * A borrowed buffer. It is given back to the pool on destruction.
+		 * Memory of the buffer is accounted by its capacity; commit and uncommit must be called when it changes.
+		 */
+		class Lease {
+			friend class BufferPool;
+
+			BufferPool *pool_ = nullptr;
+			ReservedBuffer buffer_;
+			// bytes accounted against the memory limit
+			std::size_t accounted_ = 0;
+			// bytes that may be resident because they were touched
+			std::size_t high_water_ = 0;
+
+			Lease(BufferPool *pool, ReservedBuffer buffer, std::size_t accounted, std::size_t high_water)
+				: pool_{pool}, buffer_{std::move(buffer)}, accounted_{accounted}, high_water_{high_water} {
+				mapAccounted();
+			}
+
+			// with explicit huge pages, the accounted bytes are mapped from the huge page pool
+			void mapAccounted() noexcept {
+				if (not buffer_.commit(accounted_))
+					pool_->huge_page_fallbacks_.fetch_add(1, std::memory_order_relaxed);
+			}
+
+		public:
+			Lease(const Lease &) = delete;
+
+			Lease &operator=(const Lease &) = delete;
+
+			Lease(Lease &&other) noexcept
+				: pool_{std::exchange(other.pool_, nullptr)},
+				  buffer_{std::move(other.buffer_)},
+				  accounted_{other.accounted_},
+				  high_water_{other.high_water_} {}
+
+			~Lease() {
+				if (pool_ != nullptr)
+					pool_->giveBack(std::move(buffer_), accounted_, high_water_);
+			}
+
+			[[nodiscard]] char *data() const noexcept { return buffer_.data(); }
+
+			[[nodiscard]] std::size_t size() const noexcept { return buffer_.size(); }
+
+			/**
+			 * @return the pages backing the buffer; Transparent if explicit huge pages were requested but not available
+			 */
+			[[nodiscard]] HugePages hugePages() const noexcept { return buffer_.hugePages(); }
+
+			/**
+			 * Accounts additional bytes. Blocks while the memory limit is reached.
+			 * @throws std::bad_alloc if the memory did not become available within the grow timeout
+			 */
+			void commit(std::size_t bytes) {
+				pool_->commit(bytes, true);
+				accounted_ += bytes;
+				mapAccounted();
+			}
+
+			void uncommit(std::size_t bytes) noexcept {
+				bytes = std::min(bytes, accounted_);
+				accounted_ -= bytes;
+				pool_->uncommit(bytes);
+			}
+
+			/**
+			 * Notes that bytes up to end were written.
+			 */
+			void touched(std::size_t end) noexcept { high_water_ = std::max(high_water_, end); }
+
+			[[nodiscard]] std::size_t highWater() const noexcept { return high_water_; }
+
+			/**
+			 * Gives the memory from begin to the high water mark back to the kernel.
+			 */
+			void release(std::size_t begin) noexcept {
+				if (begin < high_water_) {
+					buffer_.release(begin, high_water_);
+					high_water_ = begin;
+				}
+			}
+
+			/**
+			 * Maps the buffer from begin on to a file, see ReservedBuffer::mapFile.
+			 * The part in the file is not resident memory, so it is not accounted.
+			 */
+			bool mapFile(std::size_t begin, int fd) noexcept {
+				high_water_ = std::min(high_water_, begin);
+				return buffer_.mapFile(begin, fd);
+			}
+
+			/**
+			 * Maps the buffer from begin on back to anonymous memory. Must be called before the buffer is given back.
+			 */
+			void mapAnonymous(std::size_t begin) noexcept {
+				high_water_ = std::min(high_water_, begin);
+				buffer_.mapAnonymous(begin);
+			}
+		};
+
+	private:
+		struct PooledBuffer {
+			ReservedBuffer buffer;
+			std::size_t high_water;
+		};
+
+		std::mutex m;
+		std::condition_variable cv;
+		Options options_;
+		// bytes accounted by borrowed buffers
+		std::size_t used_ = 0;
+		// bytes resident in pooled buffers
+		std::size_t cached_ = 0;
+		std::vector<PooledBuffer> pooled_;
+		// buffers that did not get explicit huge pages and use transparent huge pages instead
+		std::atomic<std::size_t> huge_page_fallbacks_{0};
+
+		// requires m to be locked
+		void dropPooledBuffer() {
+			cached_ -= pooled_.back().high_water;
+			pooled_.pop_back();
+		}
+
+		/**
+		 * @param growing if a borrowed buffer grows; otherwise a buffer is acquired
+		 * @throws std::bad_alloc if the memory did not become available within the grow or acquire timeout
+		 */
+		void commit(std::size_t bytes, bool growing) {
+			std::unique_lock<std::mutex> lk(m);
+			if (bytes > options_.memory_limit)
+				throw std::bad_alloc();
+			const auto deadline = std::chrono::steady_clock::now() + (growing ? options_.grow_timeout : options_.acquire_timeout);
+			while (used_ + cached_ + bytes > options_.memory_limit) {
+				if (not pooled_.empty()) {
+					dropPooledBuffer();
+					continue;
+				}
+				if (cv.wait_until(lk, deadline) == std::cv_status::timeout and used_ + cached_ + bytes > options_.memory_limit)
+					throw std::bad_alloc();
+			}
+			used_ += bytes;
+		}
+
+		void uncommit(std::size_t bytes) noexcept {
+			{
+				std::lock_guard<std::mutex> lk(m);
+				used_ -= bytes;
+			}
+			cv.notify_all();
+		}
+
+		void giveBack(ReservedBuffer buffer, std::size_t accounted, std::size_t high_water) noexcept {
+			{
+				std::lock_guard<std::mutex> lk(m);
+				used_ -= accounted;
+				if (pooled_.size() < options_.max_pooled_buffers and used_ + cached_ + high_water <= options_.memory_limit) {
+					cached_ += high_water;
+					pooled_.push_back({std::move(buffer), high_water});
+				}
+			}
+			cv.notify_all();
+		}
+
+	public:
+		BufferPool() = default;
+
+		explicit BufferPool(Options options) : options_{options} {}
+
+		/**
+		 * The pool used by the stream parsers.
+		 */
+		static BufferPool &instance() {
+			static BufferPool pool;
+			return pool;
+		}
+
+		/**
+		 * Changes the options. Buffers that are already borrowed keep their size.
+		 */
+		void setOptions(Options options) {
+			std::lock_guard<std::mutex> lk(m);
+			options_ = options;
+			pooled_.clear();
+			cached_ = 0;
+		}
+
+		/**
+		 * Borrows a buffer. Blocks while the memory limit does not allow another buffer of initial_capacity.
+		 * @param reserved_size address space of the buffer, i.e. the maximal capacity
+		 * @param initial_capacity bytes accounted for the buffer from the start
+		 * @throws std::bad_alloc if no other buffer was given back within the acquire timeout
+		 */
+		Lease acquire(std::size_t reserved_size, std::size_t initial_capacity) {
+			commit(initial_capacity, false);
+			std::unique_lock<std::mutex> lk(m);
+			for (auto it = pooled_.rbegin(); it != pooled_.rend(); ++it) {
+				if (it->buffer.size() >= initial_capacity and it->buffer.size() <= reserved_size) {
+					PooledBuffer pooled = std::move(*it);
+					pooled_.erase(std::next(it).base());
+					cached_ -= pooled.high_water;
+					// keep the pages of the initial capacity resident; they are what makes reusing the buffer cheap
+					if (pooled.high_water > initial_capacity) {
+						pooled.buffer.release(initial_capacity, pooled.high_water);
+						pooled.high_water = initial_capacity;
+					}
+					return Lease{this, std::move(pooled.buffer), initial_capacity, pooled.high_water};
+				}
+			}
+			const HugePages huge_pages = options_.huge_pages;
+			lk.unlock();
+			try {
+				return Lease{this, ReservedBuffer{reserved_size, initial_capacity, huge_pages}, initial_capacity, 0};
+			} catch (...) {
+				uncommit(initial_capacity);
+				throw;
+			}
+		}
+
+		/**
+		 * @return how often explicit huge pages were requested but the huge page pool had not enough pages left
+		 */
+		[[nodiscard]] std::size_t hugePageFallbacks() const noexcept {
+			return huge_page_fallbacks_.load(std::memory_order_relaxed);
+		}
+
+		[[nodiscard]] std::size_t usedMemory() {
+			std::lock_guard<std::mutex> lk(m);
+			return used_ + cached_;
+		}
+	};
+}// namespace Dice::rdf_parser::internal::util
+
+#endif//RDF_PARSER_BUFFERPOOL_HPP
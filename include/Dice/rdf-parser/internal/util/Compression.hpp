@@ -0,0 +1,83 @@
+#ifndef RDF_PARSER_COMPRESSION_HPP
+#define RDF_PARSER_COMPRESSION_HPP
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+
+#include <boost/iostreams/device/file.hpp>
+#include <boost/iostreams/filter/bzip2.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filter/lzma.hpp>
+#include <boost/iostreams/filter/zstd.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+namespace Dice::rdf_parser {
+	enum struct Compression {
+		None,
+		Gzip,
+		Bzip2,
+		Xz,
+		Zstd
+	};
+}// namespace Dice::rdf_parser
+
+namespace Dice::rdf_parser::internal::util {
+
+	/**
+	 * Detects the compression of a file by its magic bytes.
+	 */
+	inline Compression detectCompression(const std::filesystem::path &path) {
+		std::array<unsigned char, 6> magic{};
+		std::ifstream file{path, std::ios::binary};
+		file.read(reinterpret_cast<char *>(magic.data()), magic.size());
+		const auto read = static_cast<std::size_t>(file.gcount());
+		auto startsWith = [&](std::initializer_list<unsigned char> prefix) {
+			return read >= prefix.size() and std::equal(prefix.begin(), prefix.end(), magic.begin());
+		};
+		if (startsWith({0x1f, 0x8b}))
+			return Compression::Gzip;
+		if (startsWith({'B', 'Z', 'h'}))
+			return Compression::Bzip2;
+		if (startsWith({0xfd, '7', 'z', 'X', 'Z', 0x00}))
+			return Compression::Xz;
+		if (startsWith({0x28, 0xb5, 0x2f, 0xfd}))
+			return Compression::Zstd;
+		return Compression::None;
+	}
+
+	/**
+	 * Opens a stream that decompresses the file with the decompressor of Boost.Iostreams.
+	 * The decompressors of xz and zstd are only available if boost was built with lzma and zstd support.
+	 */
+	inline std::unique_ptr<boost::iostreams::filtering_istream> openDecompressingStream(const std::filesystem::path &path, Compression compression) {
+		namespace io = boost::iostreams;
+		auto stream = std::make_unique<io::filtering_istream>();
+		switch (compression) {
+			case Compression::Gzip:
+				stream->push(io::gzip_decompressor());
+				break;
+			case Compression::Bzip2:
+				stream->push(io::bzip2_decompressor());
+				break;
+			case Compression::Xz:
+				stream->push(io::lzma_decompressor());
+				break;
+			case Compression::Zstd:
+				stream->push(io::zstd_decompressor());
+				break;
+			case Compression::None:
+				break;
+		}
+		stream->push(io::file_source(path.string(), std::ios::in | std::ios::binary));
+		if (not stream->component<io::file_source>(stream->size() - 1)->is_open())
+			throw std::runtime_error{"Cannot open " + path.string()};
+		return stream;
+	}
+}// namespace Dice::rdf_parser::internal::util
+
+#endif//RDF_PARSER_COMPRESSION_HPP
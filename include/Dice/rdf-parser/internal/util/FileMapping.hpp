@@ -0,0 +1,76 @@
+#ifndef RDF_PARSER_FILEMAPPING_HPP
+#define RDF_PARSER_FILEMAPPING_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Dice::rdf_parser::internal::util {
+
+	/**
+	 * A file mapped read-only into memory.
+	 */
+	class FileMapping {
+		const char *data_ = nullptr;
+		std::size_t size_ = 0;
+
+	public:
+		explicit FileMapping(const std::filesystem::path &path) {
+			const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd < 0)
+				throw std::runtime_error{"Cannot open " + path.string() + ": " + std::strerror(errno)};
+			struct stat info {};
+			if (::fstat(fd, &info) != 0) {
+				const int error = errno;
+				::close(fd);
+				throw std::runtime_error{"Cannot stat " + path.string() + ": " + std::strerror(error)};
+			}
+			size_ = static_cast<std::size_t>(info.st_size);
+			if (size_ != 0) {
+				void *mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+				const int error = errno;
+				::close(fd);
+				if (mapping == MAP_FAILED)
+					throw std::runtime_error{"Cannot map " + path.string() + ": " + std::strerror(error)};
+				data_ = static_cast<const char *>(mapping);
+			} else {
+				::close(fd);
+			}
+		}
+
+		FileMapping(const FileMapping &) = delete;
+
+		FileMapping &operator=(const FileMapping &) = delete;
+
+		FileMapping(FileMapping &&other) noexcept
+			: data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)} {}
+
+		~FileMapping() {
+			if (data_ != nullptr)
+				::munmap(const_cast<char *>(data_), size_);
+		}
+
+		[[nodiscard]] const char *data() const noexcept { return data_; }
+
+		[[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+		/**
+		 * Tells the kernel how the mapping will be read, e.g. MADV_SEQUENTIAL.
+		 */
+		void advise(int advice) const noexcept {
+			if (data_ != nullptr)
+				::madvise(const_cast<char *>(data_), size_, advice);
+		}
+	};
+}// namespace Dice::rdf_parser::internal::util
+
+#endif//RDF_PARSER_FILEMAPPING_HPP
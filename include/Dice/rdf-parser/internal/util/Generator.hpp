@@ -0,0 +1,167 @@
+#ifndef RDF_PARSER_GENERATOR_HPP
+#define RDF_PARSER_GENERATOR_HPP
+
+/**
+ * A minimal coroutine generator in the spirit of C++23's std::generator.
+ * The coroutine runs in the thread of the consumer and is resumed whenever the iterator is advanced.
+ * Yielded values are handed out by reference and may be moved from by the consumer.
+ */
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace Dice::rdf_parser::internal::util {
+
+	template<typename T>
+	class Generator {
+	public:
+		using value_type = std::remove_cvref_t<T>;
+
+		struct promise_type {
+			value_type *value = nullptr;
+			std::exception_ptr error;
+
+			Generator get_return_object() noexcept {
+				return Generator{std::coroutine_handle<promise_type>::from_promise(*this)};
+			}
+
+			std::suspend_always initial_suspend() noexcept { return {}; }
+
+			std::suspend_always final_suspend() noexcept { return {}; }
+
+			// the yielded object lives until the coroutine is resumed, also if it is a temporary
+			std::suspend_always yield_value(value_type &yielded) noexcept {
+				value = std::addressof(yielded);
+				return {};
+			}
+
+			std::suspend_always yield_value(value_type &&yielded) noexcept {
+				value = std::addressof(yielded);
+				return {};
+			}
+
+			void return_void() noexcept {}
+
+			void unhandled_exception() noexcept { error = std::current_exception(); }
+
+			// co_await is not supported in generators
+			template<typename U>
+			std::suspend_never await_transform(U &&) = delete;
+		};
+
+		class iterator {
+			std::coroutine_handle<promise_type> handle_;
+
+		public:
+			using iterator_category = std::input_iterator_tag;
+			using difference_type = std::ptrdiff_t;
+			using value_type = Generator::value_type;
+
+			iterator() = default;
+
+			explicit iterator(std::coroutine_handle<promise_type> handle) noexcept : handle_{handle} {}
+
+			value_type &operator*() const noexcept { return *handle_.promise().value; }
+
+			value_type *operator->() const noexcept { return handle_.promise().value; }
+
+			iterator &operator++() {
+				handle_.resume();
+				if (handle_.done() and handle_.promise().error)
+					std::rethrow_exception(std::exchange(handle_.promise().error, nullptr));
+				return *this;
+			}
+
+			void operator++(int) { ++*this; }
+
+			friend bool operator==(const iterator &it, std::default_sentinel_t) noexcept {
+				return not it.handle_ or it.handle_.done();
+			}
+		};
+
+	private:
+		std::coroutine_handle<promise_type> handle_;
+
+		explicit Generator(std::coroutine_handle<promise_type> handle) noexcept : handle_{handle} {}
+
+	public:
+		Generator() = default;
+
+		Generator(const Generator &) = delete;
+
+		Generator &operator=(const Generator &) = delete;
+
+		Generator(Generator &&other) noexcept : handle_{std::exchange(other.handle_, nullptr)} {}
+
+		Generator &operator=(Generator &&other) noexcept {
+			std::swap(handle_, other.handle_);
+			return *this;
+		}
+
+		// destroying a suspended coroutine destroys its locals, so an unfinished parse is abandoned cleanly
+		~Generator() {
+			if (handle_)
+				handle_.destroy();
+		}
+
+		/**
+		 * Runs the coroutine up to its first value. Must be called only once.
+		 */
+		iterator begin() {
+			if (handle_) {
+				handle_.resume();
+				if (handle_.done() and handle_.promise().error)
+					std::rethrow_exception(std::exchange(handle_.promise().error, nullptr));
+			}
+			return iterator{handle_};
+		}
+
+		std::default_sentinel_t end() const noexcept { return {}; }
+	};
+
+	/**
+	 * Adapts a generator to the hasNextTriple/nextTriple protocol of the parsers.
+	 * The coroutine is resumed lazily, so hasNext() may be called any number of times before next().
+	 */
+	template<typename T>
+	class GeneratorCursor {
+		Generator<T> generator_;
+		typename Generator<T>::iterator it_;
+		bool started_ = false;
+		// the current value was handed out; the coroutine is resumed with the next call of hasNext
+		bool advance_ = false;
+
+	public:
+		explicit GeneratorCursor(Generator<T> generator) noexcept : generator_{std::move(generator)} {}
+
+		bool hasNext() {
+			if (not started_) {
+				it_ = generator_.begin();
+				started_ = true;
+			} else if (advance_) {
+				advance_ = false;
+				++it_;
+			}
+			return it_ != std::default_sentinel;
+		}
+
+		/**
+		 * @return the current value; it may be moved from. Requires that hasNext() returned true.
+		 */
+		typename Generator<T>::value_type &next() noexcept {
+			advance_ = true;
+			return *it_;
+		}
+
+		/**
+		 * The generator itself, for iterating it as a range instead of using the cursor.
+		 */
+		Generator<T> &generator() noexcept { return generator_; }
+	};
+}// namespace Dice::rdf_parser::internal::util
+
+#endif//RDF_PARSER_GENERATOR_HPP
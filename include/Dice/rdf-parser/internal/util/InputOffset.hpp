@@ -0,0 +1,21 @@
+#ifndef RDF_PARSER_INPUTOFFSET_HPP
+#define RDF_PARSER_INPUTOFFSET_HPP
+
+#include <cstddef>
+
+namespace Dice::rdf_parser::internal::util {
+
+	/**
+	 * Byte offset of the current position of a PEGTL input from the begin of the document.
+	 * Inputs with eager position tracking know it; for lazy memory inputs it is computed from the begin of the memory.
+	 */
+	template<typename ParseInput>
+	std::size_t inputOffset(const ParseInput &in) {
+		if constexpr (requires { in.byte(); })
+			return in.byte();
+		else
+			return static_cast<std::size_t>(in.current() - in.begin());
+	}
+}// namespace Dice::rdf_parser::internal::util
+
+#endif//RDF_PARSER_INPUTOFFSET_HPP
@@ -0,0 +1,65 @@
+#ifndef RDF_PARSER_PARSEERRORS_HPP
+#define RDF_PARSER_PARSEERRORS_HPP
+
+/**
+ * Translation of errors raised while parsing into RDFParsingException carrying the position of the error.
+ */
+
+#include <algorithm>
+#include <istream>
+#include <string>
+#include <string_view>
+
+#include <tao/pegtl.hpp>
+
+#include "Dice/rdf-parser/exception/RDFParsingExecption.hpp"
+
+namespace Dice::rdf_parser::internal::util {
+
+	/**
+	 * @param e error raised by PEGTL
+	 * @param document the in-memory document that was parsed
+	 * @return exception with offset, line, column and snippet. Line and column are recomputed from the offset.
+	 */
+	inline ::Dice::rdf_parser::exception::RDFParsingException fromParseError(const tao::pegtl::parse_error &e, std::string_view document) {
+		if (e.positions().empty())
+			return ::Dice::rdf_parser::exception::RDFParsingException{e.what()};
+		return ::Dice::rdf_parser::exception::RDFParsingException::at(document, e.positions().front().byte, e.what());
+	}
+
+	/**
+	 * @param e error raised by PEGTL while parsing an input that cannot be read again, e.g. a decompressed stream
+	 * @return exception with offset, line and column but without snippet
+	 */
+	inline ::Dice::rdf_parser::exception::RDFParsingException fromParseError(const tao::pegtl::parse_error &e) {
+		if (e.positions().empty())
+			return ::Dice::rdf_parser::exception::RDFParsingException{e.what()};
+		const auto &position = e.positions().front();
+		return {e.what(), position.byte, position.line, position.column, {}};
+	}
+
+	/**
+	 * @param e error raised by PEGTL while parsing a stream with eager position tracking
+	 * @param stream the seekable stream that was parsed. It is only used to read the snippet.
+	 * @param start offset in the stream where the parse started; line and column are counted from there
+	 * @return exception with offset, line, column and snippet
+	 */
+	inline ::Dice::rdf_parser::exception::RDFParsingException fromParseError(const tao::pegtl::parse_error &e, std::istream &stream, std::size_t start = 0) {
+		if (e.positions().empty())
+			return ::Dice::rdf_parser::exception::RDFParsingException{e.what()};
+		auto position = e.positions().front();
+		position.byte += start;
+		// read only the part of the line around the error; the line itself may be huge
+		const std::size_t line_begin = position.byte - (position.column - 1);
+		const std::size_t read_begin = std::max(line_begin, position.byte - std::min<std::size_t>(position.byte, 40));
+		std::string text(80, '\0');
+		stream.clear();
+		stream.seekg(static_cast<std::streamoff>(read_begin));
+		stream.read(text.data(), static_cast<std::streamsize>(text.size()));
+		text.resize(static_cast<std::size_t>(stream.gcount()));
+		return {e.what(), position.byte, position.line, position.column,
+				::Dice::rdf_parser::exception::RDFParsingException::snippetAt(text, position.byte - read_begin)};
+	}
+}// namespace Dice::rdf_parser::internal::util
+
+#endif//RDF_PARSER_PARSEERRORS_HPP
@@ -0,0 +1,240 @@
+#ifndef RDF_PARSER_RESERVEDBUFFER_HPP
+#define RDF_PARSER_RESERVEDBUFFER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace Dice::rdf_parser::internal::util {
+
+	enum struct HugePages {
+		// normal pages
+		None,
+		// ask for transparent huge pages with madvise(MADV_HUGEPAGE)
+		Transparent,
+		// use MAP_HUGETLB; huge pages are taken from the huge page pool chunk by chunk when the buffer is committed.
+		// Falls back to transparent huge pages if not enough huge pages are available.
+		Explicit
+	};
+
+	/**
+	 * A buffer backed by reserved address space.
+	 * Only the reservation is done up front; memory is committed by the kernel when a page is touched first
+	 * and can be given back with release(). The address of the buffer never changes, so pointers into it stay valid
+	 * while the used part grows.
+	 *
+	 * With explicit huge pages, the reservation is inaccessible address space. Huge pages are mapped into it by commit(),
+	 * as the kernel takes them from the huge page pool when they are mapped, not when they are touched.
+	 */
+	class ReservedBuffer {
+		char *data_ = nullptr;
+		std::size_t size_ = 0;
+		std::size_t page_size_ = pageSize();
+		HugePages huge_pages_ = HugePages::None;
+		// the buffer is accessible up to this offset; only less than size_ if the reservation is not accessible
+		std::size_t mapped_ = 0;
+		// the address space is reserved with PROT_NONE and mapped by commit()
+		bool reserved_only_ = false;
+
+		static constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+		static void *map(std::size_t size, int flags) {
+			return mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+		}
+
+		static std::size_t roundUp(std::size_t size, std::size_t multiple) noexcept {
+			return (size + multiple - 1) / multiple * multiple;
+		}
+
+		void adviseHugePages(std::size_t begin, std::size_t end) noexcept {
+#ifdef MADV_HUGEPAGE
+			if (huge_pages_ != HugePages::None and begin < end)
+				madvise(data_ + begin, end - begin, MADV_HUGEPAGE);
+#endif
+		}
+
+		// makes [begin, end) inaccessible again; the pages are given back
+		void unmap(std::size_t begin, std::size_t end) noexcept {
+			if (begin < end)
+				(void) mmap(data_ + begin, end - begin, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0);
+		}
+
+		bool reserve(std::size_t size) noexcept {
+			if (not reserved_only_) {
+				void *mapping = map(size, MAP_NORESERVE);
+				if (mapping == MAP_FAILED)
+					return false;
+				data_ = static_cast<char *>(mapping);
+				size_ = size;
+				mapped_ = size;
+				adviseHugePages(0, size_);
+				return true;
+			}
+			// MAP_HUGETLB with MAP_FIXED needs an address aligned to the huge page size
+			size = roundUp(size, huge_page_size);
+			void *mapping = mmap(nullptr, size + huge_page_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+			if (mapping == MAP_FAILED)
+				return false;
+			char *const raw = static_cast<char *>(mapping);
+			char *const aligned = raw + (huge_page_size - reinterpret_cast<std::uintptr_t>(raw) % huge_page_size) % huge_page_size;
+			if (aligned > raw)
+				munmap(raw, static_cast<std::size_t>(aligned - raw));
+			munmap(aligned + size, static_cast<std::size_t>(raw + size + huge_page_size - (aligned + size)));
+			data_ = aligned;
+			size_ = size;
+			mapped_ = 0;
+			return true;
+		}
+
+	public:
+		/**
+		 * @param size bytes of address space to reserve. If the reservation fails it is retried with half the size
+		 * until min_size is reached.
+		 * @param min_size the smallest acceptable reservation
+		 * @param huge_pages whether the buffer should be backed by huge pages
+		 */
+		explicit ReservedBuffer(std::size_t size, std::size_t min_size = 0, HugePages huge_pages = HugePages::None) : huge_pages_{huge_pages} {
+#ifdef MAP_HUGETLB
+			if (huge_pages_ == HugePages::Explicit) {
+				reserved_only_ = true;
+				page_size_ = huge_page_size;
+			}
+#else
+			if (huge_pages_ == HugePages::Explicit)
+				huge_pages_ = HugePages::Transparent;
+#endif
+			for (;;) {
+				if (reserve(size))
+					return;
+				if (size / 2 < min_size or size / 2 == 0)
+					throw std::bad_alloc();
+				size /= 2;
+			}
+		}
+
+		ReservedBuffer(const ReservedBuffer &) = delete;
+
+		ReservedBuffer &operator=(const ReservedBuffer &) = delete;
+
+		ReservedBuffer(ReservedBuffer &&other) noexcept
+			: data_{other.data_},
+			  size_{other.size_},
+			  page_size_{other.page_size_},
+			  huge_pages_{other.huge_pages_},
+			  mapped_{other.mapped_},
+			  reserved_only_{other.reserved_only_} {
+			other.data_ = nullptr;
+			other.size_ = 0;
+		}
+
+		ReservedBuffer &operator=(ReservedBuffer &&other) noexcept {
+			std::swap(data_, other.data_);
+			std::swap(size_, other.size_);
+			std::swap(page_size_, other.page_size_);
+			std::swap(huge_pages_, other.huge_pages_);
+			std::swap(mapped_, other.mapped_);
+			std::swap(reserved_only_, other.reserved_only_);
+			return *this;
+		}
+
+		~ReservedBuffer() {
+			if (data_ != nullptr)
+				munmap(data_, size_);
+		}
+
+		[[nodiscard]] char *data() const noexcept { return data_; }
+
+		[[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+		/**
+		 * @return the pages backing the buffer. Explicit turns into Transparent once huge pages were not available.
+		 */
+		[[nodiscard]] HugePages hugePages() const noexcept { return huge_pages_; }
+
+		static std::size_t pageSize() noexcept {
+			static const std::size_t page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+			return page_size;
+		}
+
+		/**
+		 * Makes [0, end) accessible. Only does something for explicit huge pages, which are mapped here.
+		 * If the huge page pool has not enough pages left, normal pages with transparent huge pages are mapped instead,
+		 * and the buffer stays with them.
+		 * @return false if huge pages were requested but not available
+		 */
+		bool commit(std::size_t end) noexcept {
+			if (not reserved_only_ or end <= mapped_)
+				return true;
+			const std::size_t new_mapped = std::min(roundUp(end, huge_page_size), size_);
+			bool huge_pages_available = true;
+#ifdef MAP_HUGETLB
+			if (huge_pages_ == HugePages::Explicit) {
+				// without MAP_NORESERVE the huge pages are reserved when mapped, so touching them later cannot fail with SIGBUS
+				if (mmap(data_ + mapped_, new_mapped - mapped_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_HUGETLB, -1, 0) != MAP_FAILED) {
+					mapped_ = new_mapped;
+					return true;
+				}
+				huge_pages_ = HugePages::Transparent;
+				huge_pages_available = false;
+			}
+#endif
+			(void) mmap(data_ + mapped_, new_mapped - mapped_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0);
+			adviseHugePages(mapped_, new_mapped);
+			mapped_ = new_mapped;
+			return huge_pages_available;
+		}
+
+		/**
+		 * Gives the memory of [begin, end) back to the kernel. Only whole pages are released; the content reads as zeros afterwards.
+		 * If the buffer is mapped by commit(), everything from begin on is unmapped and must be committed again.
+		 */
+		void release(std::size_t begin, std::size_t end) noexcept {
+			begin = roundUp(begin, page_size_);
+			if (reserved_only_) {
+				if (begin < mapped_) {
+					unmap(begin, mapped_);
+					mapped_ = begin;
+				}
+				return;
+			}
+			end = std::min(end, size_) / page_size_ * page_size_;
+			if (begin < end)
+				madvise(data_ + begin, end - begin, MADV_DONTNEED);
+		}
+
+		/**
+		 * Maps [begin, size()) to the file instead of anonymous memory. The content of that part is lost.
+		 * The file must be at least as large as the part of the mapping that is touched.
+		 * @param begin a multiple of the page size
+		 * @return false if the file cannot be mapped; the part is anonymous memory then
+		 */
+		bool mapFile(std::size_t begin, int fd) noexcept {
+			if (mmap(data_ + begin, size_ - begin, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED) {
+				mapped_ = std::min(mapped_, begin);
+				return true;
+			}
+			mapAnonymous(begin);
+			return false;
+		}
+
+		/**
+		 * Maps [begin, size()) back to anonymous memory after mapFile. The content of that part is lost.
+		 */
+		void mapAnonymous(std::size_t begin) noexcept {
+			if (reserved_only_) {
+				unmap(begin, size_);
+				mapped_ = std::min(mapped_, begin);
+				return;
+			}
+			(void) mmap(data_ + begin, size_ - begin, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0);
+			adviseHugePages(begin, size_);
+		}
+	};
+}// namespace Dice::rdf_parser::internal::util
+
+#endif//RDF_PARSER_RESERVEDBUFFER_HPP
@@ -0,0 +1,157 @@
+#ifndef RDF_PARSER_RULEPROFILER_HPP
+#define RDF_PARSER_RULEPROFILER_HPP
+
+/**
+ * Statistics collected by ProfilingControl for every grammar rule.
+ * Only used if RDF_PARSER_PROFILE_RULES is defined (see Dice/rdf-parser/internal/Turtle/Control.hpp).
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <tao/pegtl.hpp>
+
+namespace Dice::rdf_parser::internal::util {
+
+	/**
+	 * Counters of a single rule. They are atomics because the TurtleFileParser parses in its own thread.
+	 */
+	struct RuleStatistics {
+		std::string_view rule_name;
+		std::atomic<uint64_t> invocations{0};
+		std::atomic<uint64_t> successes{0};
+		std::atomic<uint64_t> failures{0};
+		std::atomic<uint64_t> bytes_consumed{0};
+		std::atomic<uint64_t> bytes_rewound{0};
+		// time spent in the rule including its sub-rules and actions
+		std::atomic<uint64_t> nanoseconds{0};
+		std::atomic<uint64_t> action_invocations{0};
+		std::atomic<uint64_t> action_nanoseconds{0};
+
+		explicit RuleStatistics(std::string_view rule_name) : rule_name(rule_name) {}
+
+		void reset() {
+			invocations = 0;
+			successes = 0;
+			failures = 0;
+			bytes_consumed = 0;
+			bytes_rewound = 0;
+			nanoseconds = 0;
+			action_invocations = 0;
+			action_nanoseconds = 0;
+		}
+	};
+
+	/**
+	 * Process wide registry of RuleStatistics. Statistics of a rule are registered when the rule is matched the first time.
+	 */
+	class RuleProfiler {
+		std::mutex m;
+		std::vector<RuleStatistics *> registered;
+
+		RuleProfiler() = default;
+
+		static void writeJsonString(std::ostream &out, std::string_view str) {
+			out << '"';
+			for (char c : str) {
+				if (c == '"' or c == '\\')
+					out << '\\' << c;
+				else if (static_cast<unsigned char>(c) < 0x20)
+					out << fmt::format("\\u{:04x}", static_cast<int>(c));
+				else
+					out << c;
+			}
+			out << '"';
+		}
+
+	public:
+		static RuleProfiler &instance() {
+			static RuleProfiler profiler;
+			return profiler;
+		}
+
+		/**
+		 * @tparam Rule grammar rule
+		 * @return the statistics of Rule. They live until the end of the program.
+		 */
+		template<typename Rule>
+		static RuleStatistics &statisticsOf() {
+			static RuleStatistics &statistics = instance().add(new RuleStatistics{tao::pegtl::demangle<Rule>()});
+			return statistics;
+		}
+
+		RuleStatistics &add(RuleStatistics *statistics) {
+			std::lock_guard<std::mutex> lk(m);
+			registered.push_back(statistics);
+			return *statistics;
+		}
+
+		/**
+		 * Sets all counters back to zero.
+		 */
+		void reset() {
+			std::lock_guard<std::mutex> lk(m);
+			for (auto *statistics : registered)
+				statistics->reset();
+		}
+
+		/**
+		 * @return the statistics of all rules that were matched at least once, ordered by descending time.
+		 */
+		std::vector<const RuleStatistics *> snapshot() {
+			std::vector<const RuleStatistics *> result;
+			{
+				std::lock_guard<std::mutex> lk(m);
+				for (auto *statistics : registered)
+					if (statistics->invocations != 0)
+						result.push_back(statistics);
+			}
+			std::sort(result.begin(), result.end(), [](const auto *a, const auto *b) { return a->nanoseconds > b->nanoseconds; });
+			return result;
+		}
+
+		/**
+		 * Writes a human readable table, one line per rule.
+		 */
+		void writeText(std::ostream &out) {
+			out << fmt::format("{:>12} {:>12} {:>12} {:>14} {:>14} {:>12} {:>12} {:>12}  {}\n",
+							   "invocations", "successes", "failures", "bytes", "rewound", "time[ms]", "actions", "action[ms]", "rule");
+			for (const auto *s : snapshot()) {
+				out << fmt::format("{:>12} {:>12} {:>12} {:>14} {:>14} {:>12.3f} {:>12} {:>12.3f}  {}\n",
+								   s->invocations.load(), s->successes.load(), s->failures.load(),
+								   s->bytes_consumed.load(), s->bytes_rewound.load(), s->nanoseconds.load() / 1e6,
+								   s->action_invocations.load(), s->action_nanoseconds.load() / 1e6,
+								   s->rule_name);
+			}
+		}
+
+		/**
+		 * Writes a JSON array with one object per rule.
+		 */
+		void writeJson(std::ostream &out) {
+			out << '[';
+			bool first = true;
+			for (const auto *s : snapshot()) {
+				if (not first)
+					out << ',';
+				first = false;
+				out << "\n  {\"rule\": ";
+				writeJsonString(out, s->rule_name);
+				out << fmt::format(", \"invocations\": {}, \"successes\": {}, \"failures\": {}, \"bytes_consumed\": {}, "
+								   "\"bytes_rewound\": {}, \"nanoseconds\": {}, \"action_invocations\": {}, \"action_nanoseconds\": {}}}",
+								   s->invocations.load(), s->successes.load(), s->failures.load(), s->bytes_consumed.load(),
+								   s->bytes_rewound.load(), s->nanoseconds.load(), s->action_invocations.load(), s->action_nanoseconds.load());
+			}
+			out << "\n]\n";
+		}
+	};
+}// namespace Dice::rdf_parser::internal::util
+
+#endif//RDF_PARSER_RULEPROFILER_HPP
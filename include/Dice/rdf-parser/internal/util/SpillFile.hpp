@@ -0,0 +1,93 @@
+#ifndef RDF_PARSER_SPILLFILE_HPP
+#define RDF_PARSER_SPILLFILE_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace Dice::rdf_parser::internal::util {
+
+	/**
+	 * An anonymous temporary file that the parts of a buffer above a threshold are mapped to (see ReservedBuffer::mapFile).
+	 * Pages of a file mapping are written back to the file under memory pressure, so they do not need to stay resident
+	 * like anonymous memory. The file has no name and is removed by the kernel when it is closed and no longer mapped.
+	 */
+	class SpillFile {
+		int fd_ = -1;
+
+	public:
+		SpillFile() = default;
+
+		/**
+		 * Creates the file. If that fails, the SpillFile is not valid().
+		 * @param directory directory on the file system that takes the spilled data
+		 */
+		explicit SpillFile(const std::filesystem::path &directory) noexcept {
+#ifdef O_TMPFILE
+			fd_ = ::open(directory.c_str(), O_TMPFILE | O_RDWR | O_CLOEXEC, 0600);
+#endif
+			if (fd_ < 0) {
+				std::string name = (directory / "rdf-parser-spill-XXXXXX").string();
+				fd_ = ::mkostemp(name.data(), O_CLOEXEC);
+				if (fd_ >= 0)
+					::unlink(name.c_str());
+			}
+		}
+
+		/**
+		 * Creates the file in the directory for temporary files, or in /tmp if there is none.
+		 */
+		static SpillFile inTemporaryDirectory() noexcept {
+			std::error_code ec;
+			auto directory = std::filesystem::temp_directory_path(ec);
+			return SpillFile{ec ? std::filesystem::path{"/tmp"} : directory};
+		}
+
+		SpillFile(const SpillFile &) = delete;
+
+		SpillFile &operator=(const SpillFile &) = delete;
+
+		SpillFile(SpillFile &&other) noexcept : fd_{std::exchange(other.fd_, -1)} {}
+
+		SpillFile &operator=(SpillFile &&other) noexcept {
+			std::swap(fd_, other.fd_);
+			return *this;
+		}
+
+		~SpillFile() {
+			if (fd_ >= 0)
+				::close(fd_);
+		}
+
+		[[nodiscard]] bool valid() const noexcept { return fd_ >= 0; }
+
+		[[nodiscard]] int fd() const noexcept { return fd_; }
+
+		/**
+		 * Allocates the blocks for the first size bytes, so writing to a mapping of them cannot fail with SIGBUS when the
+		 * file system is full.
+		 * @throws std::runtime_error if the file system has no space left
+		 */
+		void grow(std::size_t size) {
+			if (const int error = ::posix_fallocate(fd_, 0, static_cast<off_t>(size)); error != 0)
+				throw std::runtime_error{std::string{"cannot spill the input buffer to a temporary file: "} + std::strerror(error)};
+		}
+
+		/**
+		 * Gives the blocks after the first size bytes back to the file system.
+		 */
+		void shrink(std::size_t size) noexcept {
+			(void) ::ftruncate(fd_, static_cast<off_t>(size));
+		}
+	};
+}// namespace Dice::rdf_parser::internal::util
+
+#endif//RDF_PARSER_SPILLFILE_HPP
@@ -33,6 +33,16 @@ namespace Dice::sparql_parser::internal {
         */
         TriplesBlockStringParser(std::string text, const robin_hood::unordered_map<std::string, std::string> &prefix_map) : BaseStringParser<true>(std::move(text),
                                                                                                                                             prefix_map){};
+
+		/**
+		 * Parses the whole content of a source at once.
+		 * @param source an input source, see Dice/rdf-parser/InputSource.hpp
+		 * @param prefix_map defines prefixes to be added before parsing. In a robin_hood map.
+		 */
+		template<::Dice::rdf_parser::InputSource Source>
+		explicit TriplesBlockStringParser(Source source, const robin_hood::unordered_map<std::string, std::string> &prefix_map = {}) {
+			parseSource(source, prefix_map);
+		}
 	};
 }// namespace Dice::rdf_parser::Turtle::parsers
 
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <filesystem>
+#include <fstream>
+#include <ranges>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Dice/rdf-parser/TurtleArchiveParser.hpp>
+#include <Dice/rdf-parser/TurtleStringParser.hpp>
+#include <Dice/rdf-parser/internal/util/Archive.hpp>
+#include <Dice/rdf-parser/internal/util/FileMapping.hpp>
+
+#include "TestData.hpp"
+
+namespace Dice::tests::rdf_parser::archive_parser_tests {
+	using namespace Dice::rdf_parser;
+
+	class ArchiveParserTests : public ::testing::Test {
+	protected:
+		std::filesystem::path path = std::filesystem::temp_directory_path() / "rdf_parser_archive_test.tar";
+
+		void TearDown() override {
+			std::filesystem::remove(path);
+		}
+
+		void writeTar(const std::vector<std::pair<std::string, std::string>> &members) {
+			std::ofstream out{path, std::ios::binary};
+			for (const auto &[name, content] : members) {
+				std::string header(512, '\0');
+				header.replace(0, name.size(), name);
+				header.replace(100, 7, "0000644");
+				char size[12];
+				std::snprintf(size, sizeof(size), "%011zo", content.size());
+				header.replace(124, 11, size, 11);
+				header[156] = '0';
+				header.replace(257, 8, std::string{"ustar\0" "00", 8});
+				out << header << content << std::string((512 - content.size() % 512) % 512, '\0');
+			}
+			out << std::string(1024, '\0');
+		}
+	};
+
+	namespace {
+		void putLittleEndian(std::string &data, std::size_t pos, std::uint64_t value, std::size_t bytes) {
+			for (std::size_t i = 0; i < bytes; ++i, value >>= 8)
+				data[pos + i] = static_cast<char>(value & 0xff);
+		}
+
+		// a ZIP64 end of central directory record at offset 0, its locator and the end of central directory record
+		std::string zip64Archive(std::uint64_t zip64_eocd, std::uint64_t directory) {
+			std::string data(56 + 20 + 22, '\0');
+			putLittleEndian(data, 0, 0x06064b50, 4);
+			putLittleEndian(data, 32, 1, 8);
+			putLittleEndian(data, 48, directory, 8);
+			putLittleEndian(data, 56, 0x07064b50, 4);
+			putLittleEndian(data, 56 + 8, zip64_eocd, 8);
+			putLittleEndian(data, 76, 0x06054b50, 4);
+			putLittleEndian(data, 76 + 10, 0xffff, 2);
+			putLittleEndian(data, 76 + 16, 0xffffffff, 4);
+			return data;
+		}
+	}// namespace
+
+	TEST_F(ArchiveParserTests, offsetsBeyondTheArchiveAreRejected) {
+		namespace util = Dice::rdf_parser::internal::util;
+		// offsets close to 2^64 wrap around if a length is added to them
+		const std::uint64_t huge = ~std::uint64_t{0} - 8;
+		ASSERT_THROW(util::listArchiveMembers(zip64Archive(huge, 0), util::ArchiveFormat::Zip), std::runtime_error);
+		ASSERT_THROW(util::listArchiveMembers(zip64Archive(0, huge), util::ArchiveFormat::Zip), std::runtime_error);
+
+		// a base-256 size that wraps around would move the next header backwards
+		std::string tar(2048, '\0');
+		tar.replace(0, 4, "a.nt");
+		tar[124] = static_cast<char>(0x80);
+		for (std::size_t i = 125; i < 136; ++i)
+			tar[i] = static_cast<char>(0xff);
+		tar[156] = '0';
+		ASSERT_THROW(util::listArchiveMembers(tar, util::ArchiveFormat::Tar), std::runtime_error);
+	}
+
+	TEST_F(ArchiveParserTests, tarMembersAreParsedAsIndependentDocuments) {
+		writeTar({{"a.ttl", "@prefix : <http://a.example/> .\n:s :p :o1, :o2 .\n"},
+				  {"dir/b.nt", "<http://b.example/s> <http://b.example/p> \"o\" .\n"},
+				  {"README", "not rdf"}});
+		TurtleArchiveParser parser{path, [](const std::string &name) { return name != "README"; }, 2};
+		ASSERT_EQ(parser.memberNames(), (std::vector<std::string>{"a.ttl", "dir/b.nt"}));
+		ASSERT_EQ(std::ranges::distance(parser), 3);
+	}
+
+	TEST_F(ArchiveParserTests, errorNamesTheMember) {
+		writeTar({{"broken.nt", "<http://a.example/s> <http://a.example/p> .\n"}});
+		TurtleArchiveParser parser{path};
+		try {
+			(void) std::ranges::distance(parser);
+			FAIL() << "expected an RDFParsingException";
+		} catch (const exception::RDFParsingException &e) {
+			ASSERT_NE(e.reason().find("broken.nt"), std::string::npos);
+			ASSERT_EQ(e.line(), 1);
+		}
+	}
+
+	TEST_F(ArchiveParserTests, zipFileWithoutExtraction) {
+		namespace util = ::Dice::rdf_parser::internal::util;
+		// the members parsed one after another, as a reference for the parallel parse
+		std::ptrdiff_t expected = 0;
+		{
+			const util::FileMapping archive{swdfArchive()};
+			for (const auto &member : util::listArchiveMembers({archive.data(), archive.size()}, util::ArchiveFormat::Zip)) {
+				TurtleStringParser parser{memberContent(member)};
+				expected += std::ranges::distance(parser);
+			}
+		}
+		ASSERT_GT(expected, 0);
+		TurtleArchiveParser parser{swdfArchive()};
+		ASSERT_EQ(std::ranges::distance(parser), expected);
+	}
+}// namespace Dice::tests::rdf_parser::archive_parser_tests
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+
+#include <Dice/rdf-parser/internal/util/BufferPool.hpp>
+
+namespace Dice::tests::rdf_parser::buffer_pool_tests {
+	using namespace Dice::rdf_parser::internal::util;
+
+	TEST(BufferPoolTests, buffersAreReused) {
+		BufferPool pool{{.memory_limit = 4 * 1024 * 1024}};
+		char *first_data;
+		{
+			auto lease = pool.acquire(64 * 1024 * 1024, 1024 * 1024);
+			first_data = lease.data();
+			lease.data()[0] = 'x';
+			lease.touched(1);
+			ASSERT_EQ(pool.usedMemory(), 1024 * 1024);
+		}
+		auto lease = pool.acquire(64 * 1024 * 1024, 1024 * 1024);
+		ASSERT_EQ(lease.data(), first_data);
+	}
+
+	TEST(BufferPoolTests, memoryIsBounded) {
+		BufferPool pool{{.memory_limit = 2 * 1024 * 1024, .grow_timeout = std::chrono::milliseconds(10)}};
+		auto lease = pool.acquire(64 * 1024 * 1024, 1024 * 1024);
+		lease.commit(1024 * 1024);
+		ASSERT_EQ(pool.usedMemory(), 2 * 1024 * 1024);
+		ASSERT_THROW(lease.commit(1024 * 1024), std::bad_alloc);
+		lease.uncommit(1024 * 1024);
+		ASSERT_NO_THROW(lease.commit(1024 * 1024));
+	}
+
+	TEST(BufferPoolTests, acquiringGivesUpWhileTheLimitIsReached) {
+		BufferPool pool{{.memory_limit = 2 * 1024 * 1024, .acquire_timeout = std::chrono::milliseconds(10)}};
+		auto lease = pool.acquire(64 * 1024 * 1024, 2 * 1024 * 1024);
+		ASSERT_THROW(pool.acquire(64 * 1024 * 1024, 1024 * 1024), std::bad_alloc);
+		ASSERT_EQ(pool.usedMemory(), 2 * 1024 * 1024);
+		lease.uncommit(1024 * 1024);
+		ASSERT_NO_THROW(pool.acquire(64 * 1024 * 1024, 1024 * 1024));
+	}
+
+	TEST(BufferPoolTests, explicitHugePagesAreMappedWhenCommitted) {
+		std::size_t free_huge_pages = 0;
+		{
+			std::ifstream meminfo{"/proc/meminfo"};
+			for (std::string line; std::getline(meminfo, line);)
+				if (line.starts_with("HugePages_Free:"))
+					free_huge_pages = std::stoul(line.substr(line.find(':') + 1));
+		}
+		BufferPool pool{{.huge_pages = HugePages::Explicit}};
+		// far more address space than there are huge pages; only the committed part takes huge pages
+		auto lease = pool.acquire(std::size_t(1) << 40, 2 * 1024 * 1024);
+		lease.data()[0] = 'x';
+		lease.commit(2 * 1024 * 1024);
+		lease.data()[4 * 1024 * 1024 - 1] = 'x';
+		if (free_huge_pages < 2) {
+			// the fallback to transparent huge pages is reported
+			ASSERT_EQ(lease.hugePages(), HugePages::Transparent);
+			ASSERT_EQ(pool.hugePageFallbacks(), 1);
+		} else {
+			ASSERT_EQ(lease.hugePages(), HugePages::Explicit);
+			ASSERT_EQ(pool.hugePageFallbacks(), 0);
+		}
+	}
+}// namespace Dice::tests::rdf_parser::buffer_pool_tests
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <Dice/rdf-parser/internal/Turtle/Inputs/FileDescriptorReader.hpp>
+#include <Dice/rdf-parser/internal/Turtle/Inputs/ReadAheadReader.hpp>
+
+namespace Dice::tests::rdf_parser::file_descriptor_reader_tests {
+	using namespace Dice::rdf_parser::internal::Turtle::Inputs;
+
+	class FileDescriptorReaderTests : public ::testing::Test {
+	protected:
+		std::filesystem::path path = std::filesystem::temp_directory_path() / "rdf_parser_fd_reader_test.nt";
+
+		void TearDown() override {
+			std::filesystem::remove(path);
+		}
+
+		void write(const std::string &content) {
+			std::ofstream{path, std::ios::binary} << content;
+		}
+
+		static std::string read(FileDescriptorReader &reader, std::size_t length) {
+			std::string buffer(length, '\0');
+			buffer.resize(reader(buffer.data(), buffer.size()));
+			return buffer;
+		}
+	};
+
+	TEST_F(FileDescriptorReaderTests, shortReadAtTheEndOfAFile) {
+		write("0123456789");
+		FileDescriptorReader reader{path, 4};
+		ASSERT_EQ(read(reader, 4), "4567");
+		ASSERT_EQ(read(reader, 4), "89");
+		ASSERT_EQ(read(reader, 4), "");
+	}
+
+	TEST_F(FileDescriptorReaderTests, shortReadsFromAPipe) {
+		int fds[2];
+		ASSERT_EQ(::pipe(fds), 0);
+		FileDescriptorReader reader{fds[0], true};
+		// a pipe returns what is there instead of waiting for the whole length
+		ASSERT_EQ(::write(fds[1], "ab", 2), 2);
+		ASSERT_EQ(read(reader, 100), "ab");
+		ASSERT_EQ(::write(fds[1], "cdef", 4), 4);
+		::close(fds[1]);
+		ASSERT_EQ(read(reader, 100), "cdef");
+		ASSERT_EQ(read(reader, 100), "");
+	}
+
+	TEST_F(FileDescriptorReaderTests, endOfFileAtABlockBoundary) {
+		constexpr std::size_t block_size = 4096;
+		std::string content(2 * block_size, 'x');
+		content[block_size - 1] = 'a';
+		content.back() = 'b';
+		write(content);
+		{
+			FileDescriptorReader reader{path};
+			ASSERT_EQ(read(reader, block_size), content.substr(0, block_size));
+			ASSERT_EQ(read(reader, block_size), content.substr(block_size));
+			ASSERT_EQ(read(reader, block_size), "");
+			ASSERT_EQ(read(reader, block_size), "");
+		}
+		// the read-ahead thread sees a full last block and only learns about the end from the next read
+		auto file = std::make_shared<FileDescriptorReader>(path);
+		ReadAheadReader reader{[file](char *buffer, std::size_t length) { return (*file)(buffer, length); }, block_size, 2};
+		std::string read_ahead(3 * block_size, '\0');
+		std::size_t total = 0;
+		while (const std::size_t r = reader(read_ahead.data() + total, read_ahead.size() - total))
+			total += r;
+		read_ahead.resize(total);
+		ASSERT_EQ(read_ahead, content);
+		ASSERT_EQ(reader(read_ahead.data(), 1), 0);
+	}
+
+	TEST_F(FileDescriptorReaderTests, readAheadKeepsTheOrderOfBlocksAndDirectReads) {
+		std::string content(1 << 20, '\0');
+		for (std::size_t i = 0; i < content.size(); ++i)
+			content[i] = static_cast<char>('a' + i % 23);
+		// a producer that is sometimes slower than the parser makes the parser read directly into its buffer in between
+		std::size_t pos = 0;
+		std::size_t calls = 0;
+		ReadAheadReader reader{[&](char *buffer, std::size_t length) {
+								   if (++calls % 3 == 0)
+									   std::this_thread::sleep_for(std::chrono::microseconds{200});
+								   const std::size_t n = std::min({length, content.size() - pos, 1000 + calls * 37 % 5000});
+								   std::memcpy(buffer, content.data() + pos, n);
+								   pos += n;
+								   return n;
+							   },
+							   4096, 2};
+		std::string read_ahead;
+		std::string buffer(7000, '\0');
+		for (std::size_t i = 0;; ++i) {
+			const std::size_t r = reader(buffer.data(), 1 + i * 53 % buffer.size());
+			if (r == 0)
+				break;
+			read_ahead.append(buffer.data(), r);
+		}
+		ASSERT_EQ(read_ahead, content);
+	}
+
+	namespace {
+		std::atomic<int> interruptions{0};
+
+		void countInterruption(int) {
+			interruptions.fetch_add(1);
+		}
+	}// namespace
+
+	TEST_F(FileDescriptorReaderTests, readIsRestartedAfterEINTR) {
+		// without SA_RESTART a blocked read fails with EINTR when the signal arrives
+		struct sigaction action {};
+		action.sa_handler = &countInterruption;
+		sigemptyset(&action.sa_mask);
+		action.sa_flags = 0;
+		struct sigaction previous {};
+		ASSERT_EQ(::sigaction(SIGUSR1, &action, &previous), 0);
+		interruptions = 0;
+
+		int fds[2];
+		ASSERT_EQ(::pipe(fds), 0);
+		std::string result;
+		std::thread reading{[&] {
+			FileDescriptorReader reader{fds[0], true};
+			result = read(reader, 100);
+		}};
+		// interrupt the read while it waits for data
+		for (int i = 0; i < 20; ++i) {
+			std::this_thread::sleep_for(std::chrono::milliseconds{1});
+			::pthread_kill(reading.native_handle(), SIGUSR1);
+		}
+		ASSERT_EQ(::write(fds[1], "data", 4), 4);
+		reading.join();
+		::close(fds[1]);
+		::sigaction(SIGUSR1, &previous, nullptr);
+		ASSERT_GT(interruptions.load(), 0);
+		ASSERT_EQ(result, "data");
+	}
+}// namespace Dice::tests::rdf_parser::file_descriptor_reader_tests
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <Dice/rdf-parser/TurtleGeneratorParser.hpp>
+#include <Dice/rdf-parser/TurtleStringParser.hpp>
+
+namespace Dice::tests::rdf_parser::generator_parser_tests {
+	using namespace Dice::rdf_parser;
+	using Triple = Dice::rdf::Triple;
+
+	const std::string document = "@prefix : <http://a.example/> .\n"
+								 ":s :p :o1, :o2 ; :q [ :r 1.5 ] .\n"
+								 ":s :p ( 1 2 ) .\n"
+								 ":s :p \"literal\" .\n";
+
+	std::vector<Triple> expectedTriples() {
+		std::vector<Triple> expected;
+		TurtleStringParser parser{document};
+		for (const auto &triple : parser)
+			expected.push_back(triple);
+		return expected;
+	}
+
+	TEST(GeneratorParserTests, iteratorGivesTheSameTriplesAsStringParser) {
+		std::istringstream stream{document};
+		TurtleGeneratorParser parser{sources::Istream{stream}};
+		std::vector<Triple> triples;
+		for (const auto &triple : parser)
+			triples.push_back(triple);
+		ASSERT_EQ(triples, expectedTriples());
+	}
+
+	TEST(GeneratorParserTests, triplesCanBeMovedOutOfTheRange) {
+		TurtleGeneratorParser parser{sources::Memory{document}};
+		std::vector<Triple> triples;
+		for (auto &triple : parser.triples())
+			triples.push_back(std::move(triple));
+		ASSERT_EQ(triples, expectedTriples());
+	}
+
+	TEST(GeneratorParserTests, stoppingEarlyDoesNotReadTheRest) {
+		// the second statement is invalid; it is never parsed if the iteration stops after the first triple
+		const std::string text = "<http://a.example/s> <http://a.example/p> <http://a.example/o> .\n<http://a.example/s> .\n";
+		TurtleGeneratorParser parser{sources::Memory{text}};
+		for (const auto &triple : parser.triples()) {
+			ASSERT_TRUE(triple.hash());
+			break;
+		}
+	}
+
+	TEST(GeneratorParserTests, errorIsThrownWhileIterating) {
+		const std::string text = "<http://a.example/s> <http://a.example/p> <http://a.example/o> .\n<http://a.example/s> .\n";
+		std::istringstream stream{text};
+		TurtleGeneratorParser parser{sources::Istream{stream}};
+		std::size_t count = 0;
+		try {
+			for (const auto &triple : parser.triples())
+				if (triple.hash())
+					++count;
+			FAIL() << "expected an RDFParsingException";
+		} catch (const exception::RDFParsingException &e) {
+			ASSERT_EQ(e.line(), 2);
+		}
+		ASSERT_EQ(count, 1);
+	}
+	TEST(GeneratorParserTests, lazyStringParserGivesTheSameTriples) {
+		TurtleStringParser parser{document, lazy};
+		std::vector<Triple> triples;
+		for (const auto &triple : parser)
+			triples.push_back(triple);
+		ASSERT_EQ(triples, expectedTriples());
+	}
+
+	TEST(GeneratorParserTests, lazyStringParserReportsErrorsWhenReached) {
+		const std::string text = "<http://a.example/s> <http://a.example/p> <http://a.example/o> .\n<http://a.example/s> .\n";
+		TurtleStringParser parser{text, lazy};
+		ASSERT_TRUE(parser.hasNextTriple());
+		parser.nextTriple();
+		ASSERT_THROW((void) parser.hasNextTriple(), exception::RDFParsingException);
+	}
+}// namespace Dice::tests::rdf_parser::generator_parser_tests
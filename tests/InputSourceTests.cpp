@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+#include <Dice/rdf-parser/TurtleFileParser.hpp>
+#include <Dice/rdf-parser/TurtleStringParser.hpp>
+#include <Dice/sparql-parser/internal/TriplesBlockStringParser.hpp>
+
+namespace Dice::tests::rdf_parser::input_source_tests {
+	using namespace Dice::rdf_parser;
+
+	const std::string document = "@prefix : <http://a.example/> .\n"
+								 ":s :p :o1, :o2 .\n"
+								 ":s :p \"literal\" .\n";
+
+	TEST(InputSourceTests, memoryIsParsedInPlace) {
+		TurtleStringParser parser{sources::Memory{document}};
+		ASSERT_EQ(std::ranges::distance(parser), 3);
+	}
+
+	TEST(InputSourceTests, istreamWithStringParser) {
+		std::istringstream stream{document};
+		TurtleStringParser parser{sources::Istream{stream}};
+		ASSERT_EQ(std::ranges::distance(parser), 3);
+	}
+
+	TEST(InputSourceTests, callbackWithFileParser) {
+		std::size_t pos = 0;
+		// hands the document out in tiny pieces
+		Turtle::parsers::TurtleFileParser parser{sources::Callback{[&pos](char *buffer, std::size_t length) {
+			const std::size_t n = std::min({length, std::size_t(3), document.size() - pos});
+			document.copy(buffer, n, pos);
+			pos += n;
+			return n;
+		}}};
+		ASSERT_EQ(std::ranges::distance(parser), 3);
+	}
+
+	TEST(InputSourceTests, pipeWithFileParser) {
+		int fds[2];
+		ASSERT_EQ(::pipe(fds), 0);
+		std::thread writer{[&] {
+			ASSERT_EQ(::write(fds[1], document.data(), document.size()), static_cast<ssize_t>(document.size()));
+			::close(fds[1]);
+		}};
+		std::ptrdiff_t parsed = 0;
+		{
+			Turtle::parsers::TurtleFileParser parser{sources::FileDescriptor{fds[0], true, "pipe"}};
+			parsed = std::ranges::distance(parser);
+		}
+		writer.join();
+		ASSERT_EQ(parsed, 3);
+	}
+
+	TEST(InputSourceTests, openPipeIsParsedAndCancelled) {
+		int fds[2];
+		ASSERT_EQ(::pipe(fds), 0);
+		const std::string statement = "<http://a.example/s> <http://a.example/p> <http://a.example/o> .\n";
+		ASSERT_EQ(::write(fds[1], statement.data(), statement.size()), static_cast<ssize_t>(statement.size()));
+		{
+			Turtle::parsers::TurtleFileParser parser{sources::FileDescriptor{fds[0], true, "pipe"}};
+			// the writer keeps the pipe open, so the triple must be handed over before a read-ahead block is full
+			auto it = parser.begin();
+			ASSERT_TRUE(it);
+			ASSERT_EQ((*it).object().value(), "http://a.example/o");
+			// the parser is destroyed while its read-ahead thread waits for the pipe
+		}
+		::close(fds[1]);
+	}
+
+	TEST(InputSourceTests, triplesBlockFromSource) {
+		robin_hood::unordered_map<std::string, std::string> prefixes;
+		prefixes.emplace("foaf", "http://xmlns.com/foaf/0.1/");
+		Dice::sparql_parser::internal::TriplesBlockStringParser parser{sources::Memory{"?x foaf:name ?name ."}, prefixes};
+		std::size_t i = 0;
+		for (auto it = parser.begin(); it; it++)
+			++i;
+		ASSERT_EQ(i, 1);
+	}
+}// namespace Dice::tests::rdf_parser::input_source_tests
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <Dice/rdf-parser/Lint.hpp>
+
+namespace Dice::tests::rdf_parser::lint_tests {
+	using namespace Dice::rdf_parser;
+
+	std::string document(std::size_t statements, std::size_t invalid_every) {
+		std::string text = "@prefix : <http://a.example/> .\n";
+		for (std::size_t i = 0; i < statements; ++i) {
+			if (invalid_every != 0 and i % invalid_every == invalid_every - 1)
+				text += ":s" + std::to_string(i) + " :p \"unterminated .\n";
+			else
+				text += ":s" + std::to_string(i) + " :p \"\"\"multi\nline " + std::to_string(i) + ".\n\"\"\" .\n";
+		}
+		return text;
+	}
+
+	TEST(LintTests, validDocument) {
+		const auto text = document(1000, 0);
+		const auto report = lint(text, {.threads = 4, .chunk_size = 1024});
+		ASSERT_TRUE(report.valid());
+		ASSERT_EQ(report.statements, 1001);
+		ASSERT_EQ(report.bytes, text.size());
+	}
+
+	TEST(LintTests, findsAllErrorsWithTheirLines) {
+		const auto text = document(1000, 100);
+		const auto report = lint(text, {.threads = 4, .chunk_size = 1024});
+		ASSERT_EQ(report.error_count, 10);
+		ASSERT_EQ(report.statements, 1001 - 10);
+		ASSERT_EQ(report.errors.size(), 10);
+		// valid statements span three lines, invalid ones a single line
+		for (std::size_t j = 0; j < report.errors.size(); ++j)
+			ASSERT_EQ(report.errors[j].line(), 2 + 3 * (100 * j + 99) - 2 * j);
+	}
+
+	TEST(LintTests, chunkingDoesNotChangeTheResult) {
+		const auto text = document(500, 7);
+		const auto sequential = lint(text, {.threads = 1, .chunk_size = text.size()});
+		const auto parallel = lint(text, {.threads = 8, .chunk_size = 512});
+		ASSERT_EQ(parallel.error_count, sequential.error_count);
+		ASSERT_EQ(parallel.statements, sequential.statements);
+		ASSERT_EQ(parallel.errors.size(), sequential.errors.size());
+		for (std::size_t j = 0; j < parallel.errors.size(); ++j) {
+			ASSERT_EQ(parallel.errors[j].offset(), sequential.errors[j].offset());
+			ASSERT_EQ(parallel.errors[j].line(), sequential.errors[j].line());
+		}
+	}
+
+	TEST(LintTests, keepsOnlyTheFirstErrors) {
+		const auto text = document(1000, 10);
+		const auto report = lint(text, {.threads = 4, .chunk_size = 1024, .max_errors = 5});
+		ASSERT_EQ(report.error_count, 100);
+		ASSERT_EQ(report.errors.size(), 5);
+		ASSERT_EQ(report.errors.front().line(), 2 + 3 * 9);
+	}
+
+	TEST(LintTests, lintsFiles) {
+		auto path = std::filesystem::temp_directory_path() / "rdf_parser_lint.ttl";
+		{
+			std::ofstream out{path};
+			out << document(200, 50);
+		}
+		const auto report = lint(path);
+		std::filesystem::remove(path);
+		ASSERT_EQ(report.error_count, 4);
+	}
+
+	TEST(LintTests, invalidFileWithoutStatementBoundaries) {
+		// no line starts a parsable statement, so no chunk has a statement boundary and each starts at its first line
+		auto path = std::filesystem::temp_directory_path() / "rdf_parser_lint_invalid.ttl";
+		constexpr std::size_t lines = 20000;
+		{
+			std::ofstream out{path};
+			for (std::size_t i = 0; i < lines; ++i)
+				out << "<http://a.example/s" << i << "> <http://a.example/p> .\n";
+		}
+		const auto report = lint(path, {.threads = 4, .chunk_size = 4096});
+		const auto size = std::filesystem::file_size(path);
+		std::filesystem::remove(path);
+		ASSERT_GT(size, 100 * 4096);
+		ASSERT_EQ(report.statements, 0);
+		ASSERT_EQ(report.error_count, lines);
+		ASSERT_EQ(report.errors.back().line(), 1000);
+	}
+}// namespace Dice::tests::rdf_parser::lint_tests
@@ -37,4 +37,21 @@ namespace Dice::tests::rdf_parser::literals_tests {
         ASSERT_EQ(term.getIdentifier(), "\"4.2E9\"^^<http://www.w3.org/2001/XMLSchema#double>");
     }
 
+    TEST(LiteralsTests, decimalWithoutIntegerPart) {
+        Term term = parse_term(".5");
+        ASSERT_EQ(term.type(), Term::NodeType::Literal_);
+        ASSERT_EQ(term.getIdentifier(), "\".5\"^^<http://www.w3.org/2001/XMLSchema#decimal>");
+    }
+
+    TEST(LiteralsTests, doubleWithEmptyFraction) {
+        Term term = parse_term("+1.E-3");
+        ASSERT_EQ(term.type(), Term::NodeType::Literal_);
+        ASSERT_EQ(term.getIdentifier(), "\"+1.E-3\"^^<http://www.w3.org/2001/XMLSchema#double>");
+    }
+
+    TEST(LiteralsTests, integerFollowedByStatementEnd) {
+        ASSERT_TRUE(TurtleStringParser::isParsable("<http://a.example/s> <http://a.example/p> 1."));
+        ASSERT_FALSE(TurtleStringParser::isParsable("<http://a.example/s> <http://a.example/p> 1e."));
+    }
+
 }
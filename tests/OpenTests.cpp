@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <ranges>
+#include <vector>
+
+#include <Dice/rdf-parser/Open.hpp>
+
+namespace Dice::tests::rdf_parser::open_tests {
+	using namespace Dice::rdf_parser;
+
+	class OpenTests : public ::testing::Test {
+	protected:
+		std::filesystem::path path = std::filesystem::temp_directory_path() / "rdf_parser_open_test.ttl";
+
+		void SetUp() override {
+			std::ofstream out{path};
+			out << "@prefix : <http://a.example/> .\n"
+				   ":s :p :o1, :o2 .\n"
+				   ":s :p \"literal\" .\n";
+		}
+
+		void TearDown() override {
+			std::filesystem::remove(path);
+		}
+	};
+
+	TEST_F(OpenTests, smallFileIsReadIntoString) {
+		auto parser = open(path);
+		ASSERT_EQ(parser->strategy(), InputStrategy::String);
+		ASSERT_EQ(std::ranges::distance(*parser), 3);
+	}
+
+	TEST_F(OpenTests, mmapStrategy) {
+		auto parser = open(path, {.strategy = InputStrategy::Mmap});
+		ASSERT_EQ(parser->strategy(), InputStrategy::Mmap);
+		ASSERT_EQ(std::ranges::distance(*parser), 3);
+	}
+
+	TEST_F(OpenTests, mmapStrategyParsesWhileIterating) {
+		{
+			std::ofstream out{path, std::ios::app};
+			out << ":s :p .\n";
+		}
+		// the invalid statement at the end is only reached by the iteration
+		auto parser = open(path, {.strategy = InputStrategy::Mmap});
+		std::vector<Dice::rdf::Triple> batch;
+		ASSERT_EQ(parser->nextBatch(batch, 1), 1);
+		ASSERT_FALSE(parser->statistics().snapshot().done);
+		ASSERT_THROW((void) std::ranges::distance(*parser), exception::RDFParsingException);
+	}
+
+	TEST_F(OpenTests, streamStrategy) {
+		auto parser = open(path, {.strategy = InputStrategy::Stream});
+		ASSERT_EQ(parser->strategy(), InputStrategy::Stream);
+		ASSERT_EQ(std::ranges::distance(*parser), 3);
+	}
+
+	TEST_F(OpenTests, batches) {
+		auto parser = open(path);
+		std::vector<Dice::rdf::Triple> batch;
+		ASSERT_EQ(parser->nextBatch(batch, 2), 2);
+		ASSERT_EQ(parser->nextBatch(batch, 2), 1);
+		ASSERT_EQ(parser->nextBatch(batch, 2), 0);
+		ASSERT_EQ(batch.size(), 3);
+	}
+}// namespace Dice::tests::rdf_parser::open_tests
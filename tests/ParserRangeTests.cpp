@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <Dice/rdf-parser/TurtleFileParser.hpp>
+#include <Dice/rdf-parser/TurtleGeneratorParser.hpp>
+#include <Dice/rdf-parser/TurtleStringParser.hpp>
+
+namespace Dice::tests::rdf_parser::parser_range_tests {
+	using namespace Dice::rdf_parser;
+	using Triple = Dice::rdf::Triple;
+
+	static_assert(std::ranges::input_range<TurtleStringParser>);
+	static_assert(std::ranges::input_range<TurtleGeneratorParser>);
+	static_assert(std::ranges::input_range<Turtle::parsers::TurtleFileParser>);
+	static_assert(std::same_as<std::ranges::range_reference_t<TurtleStringParser>, Triple &>);
+
+	const std::string document = "@prefix : <http://a.example/> .\n"
+								 ":s :p :o1, :o2 ; :q \"literal\" .\n"
+								 ":t :p :o3 .\n";
+
+	TEST(ParserRangeTests, parsersComposeWithViews) {
+		TurtleStringParser parser{document};
+		const std::string p = "<http://a.example/p>";
+		auto objects = parser | std::views::filter([&](const Triple &triple) { return triple.predicate().getIdentifier() == p; })
+					   | std::views::transform([](Triple &triple) { return std::move(triple.object()); });
+		std::vector<std::string> values;
+		for (const auto &object : objects)
+			values.push_back(object.getIdentifier());
+		ASSERT_EQ(values, (std::vector<std::string>{"<http://a.example/o1>", "<http://a.example/o2>", "<http://a.example/o3>"}));
+	}
+
+	TEST(ParserRangeTests, triplesCanBeMovedOut) {
+		std::vector<Triple> expected;
+		{
+			TurtleStringParser parser{document};
+			for (const auto &triple : parser)
+				expected.push_back(triple);
+		}
+		TurtleStringParser parser{document};
+		std::vector<Triple> triples;
+		std::ranges::move(parser, std::back_inserter(triples));
+		ASSERT_EQ(triples, expected);
+	}
+
+	TEST(ParserRangeTests, iteratorReachesTheSentinel) {
+		TurtleStringParser parser{document};
+		auto it = std::ranges::begin(parser);
+		std::size_t count = 0;
+		for (; it != std::ranges::end(parser); ++it)
+			++count;
+		ASSERT_EQ(count, 4);
+		ASSERT_FALSE(it);
+	}
+}// namespace Dice::tests::rdf_parser::parser_range_tests
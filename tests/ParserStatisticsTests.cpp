@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Dice/rdf-parser/TurtleFileParser.hpp>
+#include <Dice/rdf-parser/TurtlePushParser.hpp>
+#include <Dice/rdf-parser/TurtleStringParser.hpp>
+
+namespace Dice::tests::rdf_parser::parser_statistics_tests {
+	using namespace Dice::rdf_parser;
+
+	std::string document(std::size_t statements) {
+		std::string text = "@prefix : <http://a.example/> .\n";
+		for (std::size_t i = 0; i < statements; ++i)
+			text += ":s" + std::to_string(i) + " :p :o1, :o2 .\n";
+		return text;
+	}
+
+	TEST(ParserStatisticsTests, stringParserCountsStatements) {
+		const auto text = document(1000);
+		TurtleStringParser parser{text};
+		const auto progress = parser.statistics().snapshot();
+		ASSERT_TRUE(progress.done);
+		ASSERT_EQ(progress.statements, 1001);
+		ASSERT_EQ(progress.directives, 1);
+		ASSERT_EQ(progress.triples, 2000);
+		ASSERT_EQ(progress.bytes_total, text.size());
+		ASSERT_EQ(progress.bytes_consumed, text.size());
+		ASSERT_EQ(*progress.fraction(), 1.0);
+#ifdef RDF_PARSER_TIME_ACTIONS
+		ASSERT_GT(progress.grammar_nanoseconds, 0);
+#else
+		ASSERT_EQ(progress.grammar_nanoseconds, 0);
+		ASSERT_EQ(progress.action_nanoseconds, 0);
+#endif
+		ASSERT_EQ(progress.refills, 0);
+	}
+
+	TEST(ParserStatisticsTests, lazyParserCountsWhileIterating) {
+		const auto text = document(100);
+		TurtleStringParser parser{text, lazy};
+		std::size_t triples = 0;
+		for (const auto &triple : parser) {
+			if (++triples == 100) {
+				const auto progress = parser.statistics().snapshot();
+				// the iterator has parsed ahead by one statement at most
+				ASSERT_FALSE(progress.done);
+				ASSERT_GE(progress.triples, 100);
+				ASSERT_LT(progress.triples, 200);
+				ASSERT_LT(progress.bytes_consumed, progress.bytes_total);
+			}
+		}
+		const auto progress = parser.statistics().snapshot();
+		ASSERT_TRUE(progress.done);
+		ASSERT_EQ(progress.triples, 200);
+	}
+
+	TEST(ParserStatisticsTests, fileParserReportsProgress) {
+		auto path = std::filesystem::temp_directory_path() / "rdf_parser_statistics.ttl";
+		const auto text = document(100'000);
+		{
+			std::ofstream out{path};
+			out << text;
+		}
+		Turtle::parsers::TurtleFileParser parser{path.string(), 1000, 100};
+		std::atomic_bool reported_done{false};
+		parser.reportProgress(std::chrono::milliseconds{1}, [&](const ParserProgress &progress) {
+			if (progress.done)
+				reported_done = true;
+		});
+		std::size_t triples = 0;
+		for (const auto &triple : parser) {
+			// a slow consumer lets the queue run full
+			if (++triples % 20'000 == 0)
+				std::this_thread::sleep_for(std::chrono::milliseconds{5});
+		}
+		ASSERT_EQ(triples, 200'000);
+		while (not reported_done)
+			std::this_thread::sleep_for(std::chrono::milliseconds{1});
+
+		const auto progress = parser.statistics().snapshot();
+		std::filesystem::remove(path);
+		ASSERT_EQ(progress.statements, 100'001);
+		ASSERT_EQ(progress.triples, 200'000);
+		ASSERT_EQ(progress.bytes_total, text.size());
+		ASSERT_EQ(progress.bytes_consumed, text.size());
+		ASSERT_GT(progress.refills, 0);
+		// the queue holds few triples, so the parser has to wait for the consumer
+		ASSERT_GT(progress.blocked_on_full_queue_nanoseconds, 0);
+		ASSERT_EQ(progress.eta()->count(), 0);
+	}
+
+	TEST(ParserStatisticsTests, pushParserCountsCompleteStatements) {
+		const auto text = document(10);
+		TurtlePushParser parser;
+		std::vector<Dice::rdf::Triple> triples;
+		for (std::size_t i = 0; i < text.size(); i += 7)
+			parser.feed(std::span<const char>{text.data() + i, std::min<std::size_t>(7, text.size() - i)}, triples);
+		parser.finish(triples);
+		const auto progress = parser.statistics().snapshot();
+		ASSERT_TRUE(progress.done);
+		ASSERT_EQ(progress.statements, 11);
+		ASSERT_EQ(progress.directives, 1);
+		ASSERT_EQ(progress.triples, triples.size());
+		ASSERT_EQ(progress.bytes_consumed, text.size());
+	}
+}// namespace Dice::tests::rdf_parser::parser_statistics_tests
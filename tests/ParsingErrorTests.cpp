@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include <Dice/rdf-parser/TurtleStringParser.hpp>
+
+namespace Dice::tests::rdf_parser::parsing_error_tests {
+	using namespace Dice::rdf_parser;
+
+	TEST(ParsingErrorTests, errorCarriesPosition) {
+		std::string first_line = "<http://a.example/s> <http://a.example/p> <http://a.example/o> .";
+		try {
+			TurtleStringParser parser(first_line + "\n<http://a.example/s> <http://a.example/p> .");
+			FAIL() << "the document must not be parsable";
+		} catch (const exception::RDFParsingException &e) {
+			ASSERT_TRUE(e.hasPosition());
+			ASSERT_EQ(e.offset(), first_line.size() + 1);
+			ASSERT_EQ(e.line(), 2);
+			ASSERT_EQ(e.column(), 1);
+			ASSERT_EQ(e.snippet(), "<http://a.example/s> <http://a.example/p> .");
+		}
+	}
+
+	TEST(ParsingErrorTests, undefinedPrefixCarriesPosition) {
+		try {
+			TurtleStringParser parser("<http://a.example/s> <http://a.example/p> undefined:o .");
+			FAIL() << "the document must not be parsable";
+		} catch (const exception::RDFParsingException &e) {
+			ASSERT_TRUE(e.hasPosition());
+			ASSERT_EQ(e.line(), 1);
+			ASSERT_NE(e.reason().find("undefined prefix"), std::string::npos);
+		}
+	}
+}// namespace Dice::tests::rdf_parser::parsing_error_tests
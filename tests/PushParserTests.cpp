@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <Dice/rdf-parser/TurtlePushParser.hpp>
+#include <Dice/rdf-parser/TurtleStringParser.hpp>
+
+namespace Dice::tests::rdf_parser::push_parser_tests {
+	using namespace Dice::rdf_parser;
+	using Triple = Dice::rdf::Triple;
+
+	const std::string document = "@prefix : <http://a.example/> .\n"
+								 ":s :p :o1, :o2 ; :q [ :r 1.5 ] .\n"
+								 "# comment\n"
+								 ":s :p ( 1 2 ) .\n"
+								 ":s :p \"\"\"long\n literal\"\"\" .\n"
+								 ":s :p 1.e5 .";
+
+	std::vector<Triple> parseInChunks(const std::string &text, std::size_t chunk_size) {
+		TurtlePushParser parser;
+		std::vector<Triple> triples;
+		for (std::size_t pos = 0; pos < text.size(); pos += chunk_size)
+			parser.feed(std::span<const char>{text.data() + pos, std::min(chunk_size, text.size() - pos)}, triples);
+		parser.finish(triples);
+		return triples;
+	}
+
+	TEST(PushParserTests, anyChunkSizeGivesTheSameTriples) {
+		std::vector<Triple> expected;
+		TurtleStringParser string_parser{document};
+		for (const auto &triple : string_parser)
+			expected.push_back(triple);
+		for (std::size_t chunk_size : {1, 2, 3, 7, 64, 4096})
+			ASSERT_EQ(parseInChunks(document, chunk_size), expected) << "chunk size " << chunk_size;
+	}
+
+	TEST(PushParserTests, completeStatementsAreEmittedPerFeed) {
+		TurtlePushParser parser;
+		std::vector<Triple> triples;
+		const std::string first = "<http://a.example/s> <http://a.example/p> <http://a.example/o> .\n<http://a.example/s> <http://a";
+		parser.feed(first, triples);
+		ASSERT_EQ(triples.size(), 1);
+		ASSERT_GT(parser.pendingBytes(), 0);
+		const std::string second = ".example/p> 1 .\n";
+		parser.feed(second, triples);
+		ASSERT_EQ(triples.size(), 2);
+		parser.finish(triples);
+		ASSERT_EQ(triples.size(), 2);
+	}
+
+	TEST(PushParserTests, errorIsReportedAtFinishWithPosition) {
+		TurtlePushParser parser;
+		std::vector<Triple> triples;
+		const std::string text = "<http://a.example/s> <http://a.example/p> <http://a.example/o> .\n<http://a.example/s> <http://a.example/p> .\n";
+		parser.feed(text, triples);
+		try {
+			parser.finish(triples);
+			FAIL() << "expected an RDFParsingException";
+		} catch (const exception::RDFParsingException &e) {
+			ASSERT_EQ(e.line(), 2);
+		}
+		ASSERT_EQ(triples.size(), 1);
+	}
+}// namespace Dice::tests::rdf_parser::push_parser_tests
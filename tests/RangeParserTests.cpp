@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <Dice/rdf-parser/TurtleRangeParser.hpp>
+#include <Dice/rdf-parser/TurtleStringParser.hpp>
+
+namespace Dice::tests::rdf_parser::range_parser_tests {
+	using namespace Dice::rdf_parser;
+	using Triple = Dice::rdf::Triple;
+
+	std::string document() {
+		std::ostringstream out;
+		out << "@prefix : <http://a.example/> .\n";
+		for (int i = 0; i < 2000; ++i) {
+			if (i == 1000)
+				out << "@prefix b: <http://b.example/> .\n";
+			if (i % 3 == 0)
+				out << ":s" << i << " :p \"\"\"multi\nline.\n\"\"\" ; :q " << i << " .\n";
+			else
+				out << (i > 1000 ? "b:s" : ":s") << i << " :p :o" << i << " .\n";
+		}
+		return out.str();
+	}
+
+	std::vector<std::string> identifiers(std::vector<Triple> triples) {
+		std::vector<std::string> result;
+		for (const auto &triple : triples)
+			result.push_back(triple.subject().getIdentifier() + " " + triple.predicate().getIdentifier() + " " + triple.object().getIdentifier());
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+	TEST(RangeParserTests, shardsTogetherEqualASequentialParse) {
+		const std::string text = document();
+		const auto path = std::filesystem::temp_directory_path() / "rdf_parser_shards.ttl";
+		{
+			std::ofstream out{path};
+			out << text;
+		}
+		std::vector<Triple> expected;
+		{
+			TurtleStringParser parser{text};
+			for (const auto &triple : parser)
+				expected.push_back(triple);
+		}
+		for (std::size_t count : {1, 2, 3, 7, 64}) {
+			std::vector<Triple> triples;
+			std::size_t previous_end = 0;
+			for (std::size_t index = 0; index < count; ++index) {
+				TurtleRangeParser parser{path, Shard{index, count}};
+				ASSERT_EQ(parser.beginOffset(), previous_end);
+				previous_end = parser.endOffset();
+				for (auto &triple : parser)
+					triples.push_back(std::move(triple));
+			}
+			ASSERT_EQ(previous_end, text.size());
+			ASSERT_EQ(identifiers(triples), identifiers(expected)) << count << " shards";
+		}
+		std::filesystem::remove(path);
+	}
+
+	TEST(RangeParserTests, rangeStartsAtTheNextStatement) {
+		const std::string text = "<http://a.example/s> <http://a.example/p> 1 .\n<http://a.example/s> <http://a.example/p> 2 .\n";
+		const auto path = std::filesystem::temp_directory_path() / "rdf_parser_range.nt";
+		{
+			std::ofstream out{path};
+			out << text;
+		}
+		TurtleRangeParser parser{path, 1, text.size()};
+		std::vector<Triple> triples;
+		for (auto &triple : parser)
+			triples.push_back(std::move(triple));
+		std::filesystem::remove(path);
+		ASSERT_EQ(triples.size(), 1);
+		ASSERT_EQ(parser.beginOffset(), text.find('\n') + 1);
+	}
+}// namespace Dice::tests::rdf_parser::range_parser_tests
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <ranges>
+#include <sstream>
+#include <string>
+
+#ifndef RDF_PARSER_PROFILE_RULES
+#error "RuleProfilerTests must be compiled with RDF_PARSER_PROFILE_RULES"
+#endif
+
+#include <Dice/rdf-parser/TurtleStringParser.hpp>
+#include <Dice/rdf-parser/internal/util/RuleProfiler.hpp>
+
+namespace Dice::tests::rdf_parser::rule_profiler_tests {
+	using namespace Dice::rdf_parser;
+	namespace Turtle = Dice::rdf_parser::internal::Turtle;
+	namespace util = Dice::rdf_parser::internal::util;
+
+	template<typename Rule>
+	util::RuleStatistics &statisticsOf() {
+		return util::RuleProfiler::statisticsOf<Rule>();
+	}
+
+	TEST(RuleProfilerTests, countsSuccessesAndFailures) {
+		util::RuleProfiler::instance().reset();
+		// a statement is tried as a triple first, so the PREFIX directive and the end of the document fail as triples
+		TurtleStringParser parser{"PREFIX : <http://a.example/>\n:s :p :o .\n"};
+		ASSERT_EQ(std::ranges::distance(parser), 1);
+
+		const auto &statement = statisticsOf<Turtle::Grammar::statement>();
+		ASSERT_EQ(statement.invocations.load(), 3);
+		ASSERT_EQ(statement.successes.load(), 2);
+		ASSERT_EQ(statement.failures.load(), 1);
+
+		const auto &triple = statisticsOf<Turtle::Grammar::tripleExtended<false>>();
+		ASSERT_EQ(triple.invocations.load(), 3);
+		ASSERT_EQ(triple.successes.load(), 1);
+		ASSERT_EQ(triple.failures.load(), 2);
+		ASSERT_EQ(triple.bytes_consumed.load(), std::string{":s :p :o ."}.size());
+
+		const auto &prefix = statisticsOf<Turtle::Grammar::sparqlPrefix>();
+		ASSERT_EQ(prefix.invocations.load(), 2);
+		ASSERT_EQ(prefix.successes.load(), 1);
+		ASSERT_EQ(prefix.failures.load(), 1);
+		ASSERT_EQ(prefix.bytes_consumed.load(), std::string{"PREFIX : <http://a.example/>"}.size());
+
+		// the action of the statement rule ran once per statement
+		ASSERT_EQ(statement.action_invocations.load(), 2);
+	}
+
+	TEST(RuleProfilerTests, countsBytesRewoundBySubRules) {
+		util::RuleProfiler::instance().reset();
+		// as a triple, "PREFIX" matches PN_PREFIX before PNAME_NS misses the ':', so the subject is rewound by PNAME_NS
+		// before tripleExtended fails at the offset it started from
+		TurtleStringParser parser{"PREFIX : <http://a.example/>\n:s :p :o .\n"};
+		ASSERT_EQ(std::ranges::distance(parser), 1);
+
+		const auto prefixName = std::string{"PREFIX"}.size();
+		ASSERT_GE(statisticsOf<Turtle::Grammar::PNAME_NS>().bytes_rewound.load(), prefixName);
+		ASSERT_GE(statisticsOf<Turtle::Grammar::tripleExtended<false>>().bytes_rewound.load(), prefixName);
+		ASSERT_GE(statisticsOf<Turtle::Grammar::subject<false>>().bytes_rewound.load(), prefixName);
+		ASSERT_TRUE(Turtle::profiling::frames.empty());
+	}
+
+	TEST(RuleProfilerTests, unwindKeepsFramesBalanced) {
+		util::RuleProfiler::instance().reset();
+		// the second statement is invalid, so must<turtleDoc, eof> raises a parse_error that unwinds the enclosing rules
+		ASSERT_THROW(TurtleStringParser("<http://a.example/s> <http://a.example/p> <http://a.example/o> .\n"
+										"<http://a.example/s> <http://a.example/p> .\n"),
+					 exception::RDFParsingException);
+		ASSERT_TRUE(Turtle::profiling::frames.empty());
+
+		const auto &statement = statisticsOf<Turtle::Grammar::statement>();
+		ASSERT_EQ(statement.invocations.load(), 2);
+		ASSERT_EQ(statement.successes.load(), 1);
+		ASSERT_EQ(statement.failures.load(), 1);
+
+		// a rule that is unwound counts as invoked, but neither as success nor as failure
+		const auto &grammar = statisticsOf<Turtle::Grammar::grammar<false>>();
+		ASSERT_EQ(grammar.invocations.load(), 1);
+		ASSERT_EQ(grammar.successes.load(), 0);
+		ASSERT_EQ(grammar.failures.load(), 0);
+
+		// frames of the unwound rules do not leak into the next parse
+		TurtleStringParser parser{"<http://a.example/s> <http://a.example/p> <http://a.example/o> .\n"};
+		ASSERT_EQ(std::ranges::distance(parser), 1);
+		ASSERT_TRUE(Turtle::profiling::frames.empty());
+		ASSERT_EQ(grammar.invocations.load(), 2);
+		ASSERT_EQ(grammar.successes.load(), 1);
+	}
+
+	TEST(RuleProfilerTests, writesEveryMatchedRule) {
+		util::RuleProfiler::instance().reset();
+		TurtleStringParser parser{"<http://a.example/s> <http://a.example/p> \"o\" .\n"};
+		std::ostringstream text;
+		util::RuleProfiler::instance().writeText(text);
+		ASSERT_NE(text.str().find("turtleString"), std::string::npos);
+		std::ostringstream json;
+		util::RuleProfiler::instance().writeJson(json);
+		ASSERT_EQ(json.str().front(), '[');
+		ASSERT_NE(json.str().find("\"failures\""), std::string::npos);
+	}
+}// namespace Dice::tests::rdf_parser::rule_profiler_tests
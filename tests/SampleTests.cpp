@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <Dice/rdf-parser/Sample.hpp>
+
+namespace Dice::tests::rdf_parser::sample_tests {
+	using namespace Dice::rdf_parser;
+
+	std::filesystem::path writeTurtle(const std::string &name, std::size_t statements) {
+		auto path = std::filesystem::temp_directory_path() / name;
+		std::ofstream out{path};
+		out << "@prefix : <http://a.example/> .\n";
+		for (std::size_t i = 0; i < statements; ++i) {
+			if (i % 2 == 0)
+				out << ":s" << i << " :p" << i % 4 << " \"value " << i << "\" .\n";
+			else
+				out << ":s" << i << " :p" << i % 4 << " \"\"\"multi\nline " << i << ".\n\"\"\" .\n";
+		}
+		return path;
+	}
+
+	TEST(SampleTests, estimatesFromRandomWindows) {
+		const auto path = writeTurtle("rdf_parser_sample.ttl", 20000);
+		SampleOptions options;
+		options.sample_size = 100;
+		options.windows = 16;
+		options.window_size = 4096;
+		options.seed = 42;
+		const auto file_size = std::filesystem::file_size(path);
+		const auto result = sample(path, options);
+		std::filesystem::remove(path);
+
+		ASSERT_EQ(result.triples.size(), 100);
+		ASSERT_EQ(result.failed_windows, 0);
+		// every window ends with the first statement that ends at least window_size bytes after its begin
+		ASSERT_LT(result.bytes_parsed, file_size);
+		ASSERT_LE(result.bytes_parsed, options.windows * (options.window_size + 100));
+		ASSERT_NEAR(static_cast<double>(result.estimated_triples), 20000.0, 4000.0);
+		ASSERT_EQ(result.predicate_distribution.size(), 4);
+		double total = 0;
+		for (const auto &[predicate, share] : result.predicate_distribution) {
+			ASSERT_EQ(predicate.rfind("<http://a.example/p", 0), 0);
+			ASSERT_NEAR(share, 0.25, 0.1);
+			total += share;
+		}
+		ASSERT_NEAR(total, 1.0, 1e-9);
+	}
+
+	TEST(SampleTests, windowsWithLatePrefixesAreCountedAsFailed) {
+		const auto path = std::filesystem::temp_directory_path() / "rdf_parser_sample_late_prefix.ttl";
+		{
+			std::ofstream out{path};
+			out << "@prefix : <http://a.example/> .\n";
+			for (std::size_t i = 0; i < 2000; ++i)
+				out << ":s" << i << " :p :o .\n";
+			// declared after header_size, so windows behind it cannot resolve it
+			out << "@prefix late: <http://b.example/> .\n";
+			for (std::size_t i = 0; i < 2000; ++i)
+				out << "late:s" << i << " late:p late:o .\n";
+		}
+		SampleOptions options;
+		options.windows = 16;
+		options.window_size = 1024;
+		options.header_size = 64;
+		options.seed = 42;
+		const auto result = sample(path, options);
+		std::filesystem::remove(path);
+
+		ASSERT_GT(result.failed_windows, 0);
+		ASSERT_LT(result.failed_windows, options.windows);
+		ASSERT_GT(result.triples_parsed, 0);
+	}
+
+	TEST(SampleTests, smallFilesAreParsedCompletely) {
+		const auto path = writeTurtle("rdf_parser_sample_small.ttl", 10);
+		const auto result = sample(path, SampleOptions{});
+		std::filesystem::remove(path);
+		ASSERT_EQ(result.triples_parsed, 10);
+		ASSERT_EQ(result.estimated_triples, 10);
+		ASSERT_EQ(result.triples.size(), 10);
+		ASSERT_EQ(result.failed_windows, 0);
+	}
+}// namespace Dice::tests::rdf_parser::sample_tests
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Dice/rdf-parser/StatementIndex.hpp>
+#include <Dice/rdf-parser/TurtleRangeParser.hpp>
+#include <Dice/rdf-parser/TurtleStringParser.hpp>
+
+namespace Dice::tests::rdf_parser::statement_index_tests {
+	using namespace Dice::rdf_parser;
+	using Triple = Dice::rdf::Triple;
+
+	// statement 0 is the prefix, every other statement has two triples
+	std::string document() {
+		std::ostringstream out;
+		out << "@prefix : <http://a.example/> .\n";
+		for (int i = 0; i < 3000; ++i)
+			out << ":s" << i << " :p [ :r " << i << " ] .\n";
+		return out.str();
+	}
+
+	struct IndexedFile {
+		std::filesystem::path path = std::filesystem::temp_directory_path() / "rdf_parser_indexed.ttl";
+		std::string text;
+		std::vector<Triple> expected;
+
+		explicit IndexedFile(std::string content = document()) : text{std::move(content)} {
+			std::ofstream out{path};
+			out << text;
+			out.close();
+			TurtleStringParser parser{text};
+			for (auto &triple : parser)
+				expected.push_back(std::move(triple));
+		}
+
+		~IndexedFile() {
+			std::filesystem::remove(path);
+			std::filesystem::remove(StatementIndex::sidecarPath(path));
+		}
+	};
+
+	TEST(StatementIndexTests, sidecarIsReusedUntilTheFileChanges) {
+		IndexedFile file;
+		const auto index = StatementIndex::loadOrBuild(file.path, 4096);
+		ASSERT_EQ(index.statements(), 3001);
+		ASSERT_GT(index.entries().size(), 10);
+
+		const auto loaded = StatementIndex::load(file.path);
+		ASSERT_TRUE(loaded.has_value());
+		ASSERT_EQ(loaded->entries().size(), index.entries().size());
+		for (std::size_t i = 0; i < index.entries().size(); ++i) {
+			ASSERT_EQ(loaded->entries()[i].offset, index.entries()[i].offset);
+			ASSERT_EQ(loaded->entries()[i].statement, index.entries()[i].statement);
+			ASSERT_EQ(loaded->entries()[i].context.blank_node_label, index.entries()[i].context.blank_node_label);
+			ASSERT_EQ(loaded->entries()[i].context.prefixes.size(), index.entries()[i].context.prefixes.size());
+		}
+
+		{
+			std::ofstream out{file.path, std::ios::app};
+			out << ":t :p :o .\n";
+		}
+		ASSERT_FALSE(StatementIndex::load(file.path).has_value());
+	}
+
+	TEST(StatementIndexTests, truncatedSidecarIsRebuilt) {
+		IndexedFile file;
+		const auto index = StatementIndex::loadOrBuild(file.path, 4096);
+		const auto sidecar = StatementIndex::sidecarPath(file.path);
+		const auto size = std::filesystem::file_size(sidecar);
+		// cuts fall into numbers as well as into the lengths and contents of strings
+		for (std::uintmax_t cut = 0; cut < size; cut += 7) {
+			std::filesystem::resize_file(sidecar, cut);
+			ASSERT_FALSE(StatementIndex::load(file.path).has_value()) << cut;
+			StatementIndex::loadOrBuild(file.path, 4096);
+			ASSERT_EQ(std::filesystem::file_size(sidecar), size);
+		}
+		const auto rebuilt = StatementIndex::load(file.path);
+		ASSERT_TRUE(rebuilt.has_value());
+		ASSERT_EQ(rebuilt->entries().size(), index.entries().size());
+	}
+
+	TEST(StatementIndexTests, redefinedPrefixesAreSaved) {
+		std::ostringstream text;
+		text << "@prefix : <http://a.example/> .\n";
+		for (int i = 0; i < 1500; ++i)
+			text << ":s" << i << " :p :o .\n";
+		text << "@prefix : <http://b.example/> .\n";
+		for (int i = 0; i < 1500; ++i)
+			text << ":s" << i << " :p :o .\n";
+		IndexedFile file{text.str()};
+		const auto index = StatementIndex::loadOrBuild(file.path, 4096);
+		ASSERT_NE(index.entries()[1].context.prefixes, index.entries().back().context.prefixes);
+
+		const auto loaded = StatementIndex::load(file.path);
+		ASSERT_TRUE(loaded.has_value());
+		ASSERT_EQ(loaded->entries().size(), index.entries().size());
+		for (std::size_t i = 0; i < index.entries().size(); ++i)
+			ASSERT_EQ(loaded->entries()[i].context.prefixes, index.entries()[i].context.prefixes);
+	}
+
+	TEST(StatementIndexTests, indexedShardsEqualASequentialParse) {
+		IndexedFile file;
+		const auto index = StatementIndex::build(file.path, 4096);
+		for (std::size_t count : {1, 3, 8}) {
+			std::vector<Triple> triples;
+			for (std::size_t i = 0; i < count; ++i) {
+				TurtleRangeParser parser{file.path, index, Shard{i, count}};
+				for (auto &triple : parser)
+					triples.push_back(std::move(triple));
+			}
+			// with the blank node counters of the index even the labels are the same
+			ASSERT_EQ(triples, file.expected) << count << " shards";
+		}
+	}
+
+	TEST(StatementIndexTests, parsingStartsAtAStatementNumber) {
+		IndexedFile file;
+		const auto index = StatementIndex::build(file.path, 4096);
+		const std::size_t first = 1234;
+		TurtleRangeParser parser{file.path, index, StatementNumber{first}};
+		std::vector<Triple> triples;
+		for (auto &triple : parser)
+			triples.push_back(std::move(triple));
+		const std::vector<Triple> expected(file.expected.begin() + 2 * static_cast<long>(first - 1), file.expected.end());
+		ASSERT_EQ(triples, expected);
+	}
+}// namespace Dice::tests::rdf_parser::statement_index_tests
@@ -0,0 +1,74 @@
+#ifndef RDF_PARSER_TESTS_TESTDATA_HPP
+#define RDF_PARSER_TESTS_TESTDATA_HPP
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <unistd.h>
+
+#include <Dice/rdf-parser/internal/util/Archive.hpp>
+#include <Dice/rdf-parser/internal/util/FileMapping.hpp>
+
+namespace Dice::tests::rdf_parser {
+
+	/**
+	 * @return the absolute path of swdf.zip, which is downloaded into the binary folder of the tests by tests/CMakeLists.txt
+	 */
+	inline std::filesystem::path swdfArchive() {
+		return std::filesystem::path{RDF_PARSER_TEST_DIR} / "swdf.zip";
+	}
+
+	/**
+	 * @return the content of an archive member, decompressed if it is deflated
+	 */
+	inline std::string memberContent(const ::Dice::rdf_parser::internal::util::ArchiveMember &member) {
+		namespace util = ::Dice::rdf_parser::internal::util;
+		if (member.method == util::ArchiveMember::Method::Stored)
+			return std::string{member.data};
+		std::string content;
+		util::inflateMember(member, content);
+		return content;
+	}
+
+	/**
+	 * @return swdf.nt from swdf.zip as a plain file for the file parsers. It is written to the directory for temporary
+	 * files the first time it is needed and removed when the process exits. ctest runs every test in a process of its
+	 * own and possibly in parallel, so every process writes a file of its own.
+	 */
+	inline const std::filesystem::path &swdfFile() {
+		struct ExtractedFile {
+			std::filesystem::path path;
+
+			ExtractedFile() {
+				namespace util = ::Dice::rdf_parser::internal::util;
+				const util::FileMapping archive{swdfArchive()};
+				const std::string_view data{archive.data(), archive.size()};
+				for (const auto &member : util::listArchiveMembers(data, util::ArchiveFormat::Zip)) {
+					if (member.name.ends_with(".nt")) {
+						path = std::filesystem::temp_directory_path() / ("rdf_parser_swdf_" + std::to_string(::getpid()) + ".nt");
+						std::ofstream{path, std::ios::binary} << memberContent(member);
+						return;
+					}
+				}
+				throw std::runtime_error{"swdf.zip has no N-Triples member"};
+			}
+
+			ExtractedFile(const ExtractedFile &) = delete;
+
+			ExtractedFile &operator=(const ExtractedFile &) = delete;
+
+			~ExtractedFile() {
+				std::error_code ec;
+				std::filesystem::remove(path, ec);
+			}
+		};
+		static const ExtractedFile file;
+		return file.path;
+	}
+}// namespace Dice::tests::rdf_parser
+
+#endif//RDF_PARSER_TESTS_TESTDATA_HPP
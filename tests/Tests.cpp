@@ -9,6 +9,20 @@
 #include "TurtleOfficialPositiveTests.cpp"
 #include "TurtleParserFilesTests.cpp"
 #include "LiteralsTest.cpp"
+#include "ParsingErrorTests.cpp"
+#include "OpenTests.cpp"
+#include "BufferPoolTests.cpp"
+#include "ArchiveParserTests.cpp"
+#include "InputSourceTests.cpp"
+#include "FileDescriptorReaderTests.cpp"
+#include "PushParserTests.cpp"
+#include "GeneratorParserTests.cpp"
+#include "ParserRangeTests.cpp"
+#include "SampleTests.cpp"
+#include "RangeParserTests.cpp"
+#include "StatementIndexTests.cpp"
+#include "LintTests.cpp"
+#include "ParserStatisticsTests.cpp"
 
 int main(int argc, char **argv) {
 	testing::InitGoogleTest(&argc, argv);
@@ -1,13 +1,31 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <zstd.h>
+
 #include <Dice/rdf-parser/TurtleFileParser.hpp>
 
+#include "TestData.hpp"
+
 namespace Dice::tests::rdf_parser::turtle_parser_concurrent_tests {
 	using namespace Dice::rdf_parser::Turtle::parsers;
 
 	TEST(TurtleParserFilesTests, parseSWDF) {
-		std::filesystem::current_path(std::filesystem::canonical("/proc/self/exe").parent_path());
-		TurtleFileParser parser{"../tests/datasets/swdf.nt"};
+		TurtleFileParser parser{swdfFile().string()};
 		long i = 0;
 		for (const auto &item : parser) {
 			if (item.hash())
@@ -15,4 +33,343 @@ namespace Dice::tests::rdf_parser::turtle_parser_concurrent_tests {
 		}
 		ASSERT_TRUE(i > 0);
 	}
+
+	TEST(TurtleParserFilesTests, limitStopsAfterNTriples) {
+		TurtleFileParser parser{swdfFile().string()};
+		parser.limit(1000);
+		ASSERT_EQ(std::ranges::distance(parser), 1000);
+	}
+
+	TEST(TurtleParserFilesTests, stoppingEarlyShutsDownTheParsingThread) {
+		// with a small queue the parsing thread waits for the consumer when the parser is destroyed
+		TurtleFileParser parser{swdfFile().string(), 10, 1};
+		std::size_t count = 0;
+		for (const auto &item : parser) {
+			if (item.hash())
+				++count;
+			if (count == 100)
+				break;
+		}
+		ASSERT_EQ(count, 100);
+	}
+
+	TEST(TurtleParserFilesTests, cancellationFromTheToken) {
+		TurtleFileParser parser{swdfFile().string(), 10, 1};
+		auto token = parser.cancellationToken();
+		std::size_t count = 0;
+		for (const auto &item : parser) {
+			if (item.hash() and ++count == 5)
+				token.cancel();
+		}
+		ASSERT_EQ(count, 5);
+	}
+
+	TEST(TurtleParserFilesTests, statementLargerThanInitialBuffer) {
+		auto path = std::filesystem::temp_directory_path() / "rdf_parser_large_literal.nt";
+		const std::string large_value(8 * ::Dice::rdf_parser::internal::Turtle::Configurations::RdfConcurrentStreamParser_BufferSize, 'x');
+		{
+			std::ofstream out{path};
+			out << "<http://a.example/s> <http://a.example/p> \"small\" .\n";
+			out << "<http://a.example/s> <http://a.example/p> \"" << large_value << "\" .\n";
+			out << "<http://a.example/s> <http://a.example/p> \"small\" .\n";
+		}
+		std::size_t count = 0;
+		bool found_large = false;
+		{
+			TurtleFileParser parser{path.string()};
+			for (const auto &triple : parser) {
+				++count;
+				if (triple.object().getIdentifier().size() > large_value.size())
+					found_large = true;
+			}
+		}
+		std::filesystem::remove(path);
+		ASSERT_EQ(count, 3);
+		ASSERT_TRUE(found_large);
+	}
+
+	TEST(TurtleParserFilesTests, largeStatementIsSpilledToAFile) {
+		namespace Inputs = ::Dice::rdf_parser::internal::Turtle::Inputs;
+		std::string text(16 * 1024 * 1024, '\0');
+		for (std::size_t i = 0; i < text.size(); ++i)
+			text[i] = static_cast<char>('a' + i % 26);
+		text += " .\n";
+		std::istringstream stream{text};
+		Inputs::IstreamInput<> input{"spill", 1024 * 1024, std::size_t(1) << 30, stream};
+		input.spillAbove(2 * 1024 * 1024);
+		ASSERT_EQ(input.size(text.size()), text.size());
+		ASSERT_GT(input.buffer_spilled(), 0);
+		ASSERT_TRUE(std::equal(text.begin(), text.end(), input.current()));
+		// the part above the threshold goes back to memory once the buffer shrinks below it
+		input.bump(text.size() - 3);
+		input.discard();
+		ASSERT_EQ(input.buffer_spilled(), 0);
+		ASSERT_EQ(std::string_view(input.current(), 3), " .\n");
+	}
+
+	TEST(TurtleParserFilesTests, gzipCompressedFile) {
+		auto path = std::filesystem::temp_directory_path() / "rdf_parser_compressed.nt.gz";
+		{
+			std::ofstream file{path, std::ios::binary};
+			boost::iostreams::filtering_ostream out;
+			out.push(boost::iostreams::gzip_compressor());
+			out.push(file);
+			for (int i = 0; i < 1000; ++i)
+				out << "<http://a.example/s" << i << "> <http://a.example/p> \"" << i << "\" .\n";
+		}
+		std::ptrdiff_t count = 0;
+		{
+			TurtleFileParser parser{path.string()};
+			count = std::ranges::distance(parser);
+		}
+		std::filesystem::remove(path);
+		ASSERT_EQ(count, 1000);
+	}
+
+	TEST(TurtleParserFilesTests, zstdMultiFrameFileIsDecompressedInParallel) {
+		auto path = std::filesystem::temp_directory_path() / "rdf_parser_compressed.nt.zst";
+		{
+			std::ofstream file{path, std::ios::binary};
+			// one frame per 100 statements, as written by zstd --rsyncable or pzstd
+			for (int frame = 0; frame < 10; ++frame) {
+				std::string text;
+				for (int i = 0; i < 100; ++i)
+					text += "<http://a.example/s" + std::to_string(frame * 100 + i) + "> <http://a.example/p> \"" + std::to_string(i) + "\" .\n";
+				std::string compressed(ZSTD_compressBound(text.size()), '\0');
+				compressed.resize(ZSTD_compress(compressed.data(), compressed.size(), text.data(), text.size(), 3));
+				file << compressed;
+			}
+		}
+		ASSERT_TRUE(::Dice::rdf_parser::internal::Turtle::Inputs::ParallelDecompressingReader::splittable(path, ::Dice::rdf_parser::Compression::Zstd));
+		std::ptrdiff_t count = 0;
+		{
+			TurtleFileParser parser{path.string()};
+			count = std::ranges::distance(parser);
+		}
+		std::filesystem::remove(path);
+		ASSERT_EQ(count, 1000);
+	}
+	TEST(TurtleParserFilesTests, resumeFromCheckpointYieldsTheRemainingTriples) {
+		auto path = std::filesystem::temp_directory_path() / "rdf_parser_checkpoint.ttl";
+		{
+			std::ofstream out{path};
+			out << "@prefix ex: <http://a.example/> .\n";
+			for (int i = 0; i < 200; ++i) {
+				if (i == 100)
+					out << "@prefix ex2: <http://b.example/> .\n";
+				out << "ex:s" << i << " ex:p [ ex:q " << i << " ] ; ex:r _:x" << i << " .\n";
+				if (i >= 100)
+					out << "ex2:s" << i << " ex:p \"" << i << "\" .\n";
+			}
+		}
+		auto text = [](const auto &triple) {
+			return triple.subject().getIdentifier() + ' ' + triple.predicate().getIdentifier() + ' ' + triple.object().getIdentifier();
+		};
+
+		std::vector<std::string> all;
+		std::optional<::Dice::rdf_parser::Checkpoint> checkpoint;
+		{
+			TurtleFileParser parser{path.string(), {.checkpoint_interval = 1}};
+			for (const auto &triple : parser) {
+				all.push_back(text(triple));
+				// take a checkpoint after the second prefix was defined
+				if (all.size() >= 400 and not checkpoint)
+					checkpoint = parser.checkpoint();
+			}
+		}
+		ASSERT_TRUE(checkpoint.has_value());
+		ASSERT_EQ(checkpoint->context.prefixes.size(), 2);
+
+		const auto restored = ::Dice::rdf_parser::Checkpoint::deserialize(checkpoint->serialize());
+		ASSERT_EQ(restored.offset, checkpoint->offset);
+		ASSERT_EQ(restored.triples, checkpoint->triples);
+		std::vector<std::string> rest;
+		{
+			TurtleFileParser parser{path.string(), restored};
+			for (const auto &triple : parser)
+				rest.push_back(text(triple));
+		}
+		std::filesystem::remove(path);
+		ASSERT_EQ(rest, std::vector<std::string>(all.begin() + static_cast<std::ptrdiff_t>(restored.triples), all.end()));
+	}
+
+	TEST(TurtleParserFilesTests, requestedCheckpointIsRecorded) {
+		auto path = std::filesystem::temp_directory_path() / "rdf_parser_requested_checkpoint.nt";
+		{
+			std::ofstream out{path};
+			for (int i = 0; i < 100; ++i)
+				out << "<http://a.example/s" << i << "> <http://a.example/p> \"" << i << "\" .\n";
+		}
+		std::optional<::Dice::rdf_parser::Checkpoint> checkpoint;
+		{
+			// with a small queue the parsing thread is still running when the checkpoint is requested
+			TurtleFileParser parser{path.string(), 10, 1};
+			std::size_t count = 0;
+			for (const auto &triple : parser) {
+				if (triple.hash() and ++count == 5)
+					parser.requestCheckpoint();
+				if (not checkpoint)
+					checkpoint = parser.checkpoint();
+			}
+		}
+		std::filesystem::remove(path);
+		ASSERT_TRUE(checkpoint.has_value());
+		ASSERT_GT(checkpoint->triples, 0);
+		ASSERT_GT(checkpoint->offset, 0);
+	}
+
+	TEST(TurtleParserFilesTests, compressedFilesCannotBeResumed) {
+		auto path = std::filesystem::temp_directory_path() / "rdf_parser_resume_compressed.nt.gz";
+		{
+			std::ofstream file{path, std::ios::binary};
+			boost::iostreams::filtering_ostream out;
+			out.push(boost::iostreams::gzip_compressor());
+			out.push(file);
+			for (int i = 0; i < 100; ++i)
+				out << "<http://a.example/s" << i << "> <http://a.example/p> \"" << i << "\" .\n";
+		}
+		::Dice::rdf_parser::Checkpoint checkpoint;
+		checkpoint.offset = 10;
+		ASSERT_THROW(TurtleFileParser(path.string(), checkpoint), std::invalid_argument);
+		std::filesystem::remove(path);
+	}
+	TEST(TurtleParserFilesTests, followWaitsForAppendedLines) {
+		auto path = std::filesystem::temp_directory_path() / "rdf_parser_follow.nt";
+		{
+			std::ofstream out{path};
+			out << "<http://a.example/s1> <http://a.example/p> \"1\" .\n";
+			out << "<http://a.example/s2> <http://a.example/p> \"2\" .\n";
+		}
+		TurtleFileParser parser{path.string(), ::Dice::rdf_parser::follow};
+		for (int i = 0; i < 2; ++i) {
+			ASSERT_TRUE(parser.hasNextTriple());
+			parser.nextTriple();
+		}
+		std::thread writer{[&] {
+			std::ofstream out{path, std::ios::app};
+			// the line arrives in two parts; the first part alone is no statement
+			out << "<http://a.example/s3> <http://a.example/p> \"par" << std::flush;
+			std::this_thread::sleep_for(std::chrono::milliseconds(300));
+			out << "tial\" .\n" << std::flush;
+		}};
+		ASSERT_TRUE(parser.hasNextTriple());
+		parser.nextTriple();
+		writer.join();
+		ASSERT_EQ(parser.getCurrentTriple().object().getIdentifier(), "\"partial\"");
+
+		parser.cancel();
+		ASSERT_FALSE(parser.hasNextTriple());
+		std::filesystem::remove(path);
+	}
+	TEST(TurtleParserFilesTests, followHandsOutAnAppendedLineWhileIterating) {
+		auto path = std::filesystem::temp_directory_path() / "rdf_parser_follow_range.nt";
+		{
+			std::ofstream out{path};
+			out << "<http://a.example/s1> <http://a.example/p> \"1\" .\n";
+		}
+		TurtleFileParser parser{path.string(), ::Dice::rdf_parser::follow};
+		// a triple that stays hidden until another line arrives would block the loop; the watchdog ends it then
+		std::atomic_bool finished{false};
+		std::thread watchdog{[&] {
+			for (int i = 0; i < 50 and not finished; ++i)
+				std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			parser.cancel();
+		}};
+		std::vector<std::string> objects;
+		for (const auto &triple : parser) {
+			objects.push_back(triple.object().getIdentifier());
+			if (objects.size() == 2)
+				break;
+			// exactly one line is appended, nothing follows it
+			std::ofstream out{path, std::ios::app};
+			out << "<http://a.example/s2> <http://a.example/p> \"2\" .\n";
+		}
+		finished = true;
+		watchdog.join();
+		std::filesystem::remove(path);
+		ASSERT_EQ(objects, (std::vector<std::string>{"\"1\"", "\"2\""}));
+	}
+	TEST(TurtleParserFilesTests, recoverFromErrorsSkipsInvalidStatements) {
+		auto path = std::filesystem::temp_directory_path() / "rdf_parser_recover.ttl";
+		{
+			std::ofstream out{path};
+			for (int i = 0; i < 100; ++i)
+				out << "<http://a.example/s" << i << "> <http://a.example/p> \"" << i << "\" .\n";
+			out << "<http://a.example/bad> <http://a.example/p> \"unterminated .\n";
+			out << "<http://a.example/s> <http://a.example/p> <http://a.example/o1>, <http://a.example/o2>, bad:prefixed .\n";
+			out << "<http://a.example/s> <http://a.example/p> \"last\" .\n";
+		}
+		std::size_t count = 0;
+		bool found_partial = false;
+		{
+			TurtleFileParser parser{path.string(), {.recover_from_errors = true, .max_logged_errors = 1}};
+			for (const auto &triple : parser) {
+				++count;
+				// triples of an invalid statement are dropped together with it
+				if (triple.object().getIdentifier() == "<http://a.example/o1>")
+					found_partial = true;
+			}
+			ASSERT_EQ(parser.errors().count(), 2);
+			ASSERT_TRUE(parser.errors().truncated());
+			const auto entries = parser.errors().entries();
+			ASSERT_EQ(entries.size(), 1);
+			ASSERT_EQ(entries.front().line(), 101);
+		}
+		std::filesystem::remove(path);
+		ASSERT_EQ(count, 101);
+		ASSERT_FALSE(found_partial);
+	}
+	TEST(TurtleParserFilesTests, parseErrorIsRethrownToTheConsumer) {
+		auto path = std::filesystem::temp_directory_path() / "rdf_parser_error.nt";
+		{
+			std::ofstream out{path};
+			out << "<http://a.example/s> <http://a.example/p> \"1\" .\n";
+			out << "<http://a.example/s> <http://a.example/p> .\n";
+		}
+		TurtleFileParser parser{path.string()};
+		// the triples before the error are returned first
+		ASSERT_TRUE(parser.hasNextTriple());
+		parser.nextTriple();
+		std::size_t line = 0;
+		try {
+			while (parser.hasNextTriple())
+				parser.nextTriple();
+		} catch (const ::Dice::rdf_parser::exception::RDFParsingException &e) {
+			line = e.line();
+		}
+		std::filesystem::remove(path);
+		ASSERT_EQ(line, 2);
+	}
+
+	TEST(TurtleParserFilesTests, triplesRightBeforeAnErrorAreNotLost) {
+		auto path = std::filesystem::temp_directory_path() / "rdf_parser_error_after_triples.nt";
+		{
+			std::ofstream out{path};
+			for (int i = 0; i < 3; ++i)
+				out << "<http://a.example/s> <http://a.example/p> \"" << i << "\" .\n";
+			out << "<http://a.example/s> <http://a.example/p> .\n";
+		}
+		// the parsing thread queues the last triples and fails right after, while the consumer may find the queue empty
+		for (int run = 0; run < 200; ++run) {
+			TurtleFileParser parser{path.string()};
+			std::size_t count = 0;
+			bool failed = false;
+			try {
+				while (parser.hasNextTriple()) {
+					parser.nextTriple();
+					++count;
+				}
+			} catch (const ::Dice::rdf_parser::exception::RDFParsingException &) {
+				failed = true;
+			}
+			ASSERT_EQ(count, 3) << "run " << run;
+			ASSERT_TRUE(failed) << "run " << run;
+		}
+		std::filesystem::remove(path);
+	}
+
+	TEST(TurtleParserFilesTests, missingFileIsReportedToTheConsumer) {
+		TurtleFileParser parser{"rdf_parser_missing_file.nt"};
+		ASSERT_THROW(parser.hasNextTriple(), ::Dice::rdf_parser::exception::RDFParsingException);
+	}
 }// namespace Dice::tests::rdf_parser::turtle_parser_concurrent_tests
\ No newline at end of file
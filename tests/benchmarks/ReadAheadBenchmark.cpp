@@ -0,0 +1,103 @@
+/**
+ * Shows that ReadAheadReader overlaps reading the input with parsing it.
+ *
+ * A generated file is parsed three times: without reading (from memory), with a FileDescriptorReader called by the parser,
+ * and with the FileDescriptorReader running in the thread of a ReadAheadReader. The file is read through a reader that is
+ * throttled to the given bandwidth, as if it came from a slow disk; otherwise the page cache makes reading free.
+ * Without read-ahead the parse takes about the reading time plus the parsing time, with read-ahead about the longer of both.
+ *
+ * usage: read_ahead_benchmark [statements = 2000000] [MiB/s = 200]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <Dice/rdf-parser/internal/Turtle/Configurations.hpp>
+#include <Dice/rdf-parser/internal/Turtle/Inputs/FileDescriptorReader.hpp>
+#include <Dice/rdf-parser/internal/Turtle/Inputs/GrowingBufferInput.hpp>
+#include <Dice/rdf-parser/internal/Turtle/Inputs/ReadAheadReader.hpp>
+#include <Dice/rdf-parser/internal/Turtle/Parsers/StatementGenerator.hpp>
+
+namespace Inputs = Dice::rdf_parser::internal::Turtle::Inputs;
+namespace Parsers = Dice::rdf_parser::internal::Turtle::Parsers;
+namespace Configurations = Dice::rdf_parser::internal::Turtle::Configurations;
+using clock_type = std::chrono::steady_clock;
+
+/**
+ * Reads a file no faster than the given bandwidth.
+ */
+class ThrottledReader {
+	Inputs::FileDescriptorReader reader_;
+	double bytes_per_second_;
+
+public:
+	ThrottledReader(const std::filesystem::path &path, double bytes_per_second)
+		: reader_{path}, bytes_per_second_{bytes_per_second} {}
+
+	std::size_t operator()(char *buffer, std::size_t length) {
+		const auto start = clock_type::now();
+		const std::size_t r = reader_(buffer, length);
+		std::this_thread::sleep_until(start + std::chrono::duration_cast<clock_type::duration>(
+													  std::chrono::duration<double>(static_cast<double>(r) / bytes_per_second_)));
+		return r;
+	}
+};
+
+template<typename Input>
+std::pair<double, std::size_t> parse(std::unique_ptr<Input> input) {
+	const auto start = clock_type::now();
+	std::size_t triples = 0;
+	for (const auto &triple : Parsers::generateTriples(std::move(input))) {
+		(void) triple;
+		++triples;
+	}
+	return {std::chrono::duration<double>(clock_type::now() - start).count(), triples};
+}
+
+int main(int argc, char **argv) {
+	const std::size_t statements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+	const double bytes_per_second = (argc > 2 ? std::strtod(argv[2], nullptr) : 200.0) * 1024 * 1024;
+
+	const auto path = std::filesystem::temp_directory_path() / "rdf_parser_read_ahead_benchmark.nt";
+	std::string text;
+	for (std::size_t i = 0; i < statements; ++i)
+		text += fmt::format("<http://a.example/s{}> <http://a.example/p{}> \"literal number {}\" .\n", i, i % 100, i);
+	std::ofstream{path, std::ios::binary} << text;
+
+	const auto [cpu_seconds, triples] = parse(std::make_unique<tao::pegtl::memory_input<tao::pegtl::tracking_mode::lazy>>(text.data(), text.size(), "memory"));
+	const double io_seconds = static_cast<double>(text.size()) / bytes_per_second;
+
+	const auto [serial_seconds, serial_triples] = parse(std::make_unique<Inputs::GrowingBufferInput<ThrottledReader>>(
+			path.string(), Configurations::RdfConcurrentStreamParser_BufferSize, Configurations::RdfConcurrentStreamParser_MaxBufferSize,
+			path, bytes_per_second));
+
+	auto file = std::make_shared<ThrottledReader>(path, bytes_per_second);
+	const auto [read_ahead_seconds, read_ahead_triples] = parse(std::make_unique<Inputs::GrowingBufferInput<Inputs::ReadAheadReader>>(
+			path.string(), Configurations::RdfConcurrentStreamParser_BufferSize, Configurations::RdfConcurrentStreamParser_MaxBufferSize,
+			[file](char *buffer, std::size_t length) { return (*file)(buffer, length); },
+			Configurations::RdfConcurrentStreamParser_ReadAheadBlockSize, Configurations::RdfConcurrentStreamParser_ReadAheadBlocks));
+	std::filesystem::remove(path);
+
+	if (serial_triples != triples or read_ahead_triples != triples) {
+		std::cerr << "the parses yielded different numbers of triples\n";
+		return EXIT_FAILURE;
+	}
+	std::cout << fmt::format("{} triples, {:.1f} MiB\n", triples, static_cast<double>(text.size()) / 1024 / 1024)
+			  << fmt::format("parsing only:      {:8.3f} s\n", cpu_seconds)
+			  << fmt::format("reading only:      {:8.3f} s\n", io_seconds)
+			  << fmt::format("without read-ahead:{:8.3f} s (sum {:.3f} s)\n", serial_seconds, cpu_seconds + io_seconds)
+			  << fmt::format("with read-ahead:   {:8.3f} s (max {:.3f} s)\n", read_ahead_seconds, std::max(cpu_seconds, io_seconds))
+			  << fmt::format("overlap:           {:8.1f} %\n",
+							 100.0 * (serial_seconds - read_ahead_seconds) / std::min(cpu_seconds, io_seconds));
+	return EXIT_SUCCESS;
+}